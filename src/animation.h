@@ -1,4 +1,10 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -15,96 +21,296 @@ struct AnimationFrame {
 };
 
 /**
- * @brief Represents a complete animation sequence
+ * @brief Immutable frame data of an animation, shared by every Animation playing it
+ *
+ * frameEnds holds the running sum of the frame durations, so the frame shown
+ * at any time is found with a binary search instead of stepping through the
+ * frames. Fill the clip with AddFrame(), or call BuildTimeline() after
+ * assigning frames directly.
  */
-class Animation {
-public:
+struct AnimationClip {
     struct Frame {
         SDL_Rect sourceRect;
         float duration;
     };
 
-    // Default constructor
-    Animation() : name(""), looping(true), currentFrame(0), 
-                 elapsedTime(0.0f), isPlaying(false) {}
-
-    Animation(const std::string& name, bool looping = true)
-        : name(name), looping(looping), currentFrame(0),
-          elapsedTime(0.0f), isPlaying(false) {}
+    std::string name;
+    std::vector<Frame> frames;
+    bool looping = true;
+    std::vector<float> frameEnds;  ///< Time at which each frame ends, from the start of the clip
 
     void AddFrame(const SDL_Rect& rect, float duration) {
         frames.push_back({rect, duration});
+        frameEnds.push_back(GetDuration() + std::max(duration, 0.0f));
+    }
+
+    // Recompute frameEnds from frames
+    void BuildTimeline() {
+        frameEnds.resize(frames.size());
+        float end = 0.0f;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            end += std::max(frames[i].duration, 0.0f);
+            frameEnds[i] = end;
+        }
     }
 
-    void Play() {
-        isPlaying = true;
-        currentFrame = 0;
-        elapsedTime = 0.0f;
+    [[nodiscard]] bool HasTimeline() const { return frameEnds.size() == frames.size(); }
+
+    // Length of one pass through the clip in seconds
+    [[nodiscard]] float GetDuration() const { return frameEnds.empty() ? 0.0f : frameEnds.back(); }
+
+    /**
+     * @brief Find the frame shown at a time
+     * @param time Seconds from the start of the clip
+     * @return Index of the frame; times past the end give the last frame
+     */
+    [[nodiscard]] std::uint32_t FindFrame(float time) const {
+        if (frameEnds.empty()) return 0;
+        const auto it = std::upper_bound(frameEnds.begin(), frameEnds.end(), time);
+        const auto index = static_cast<std::uint32_t>(it - frameEnds.begin());
+        return std::min(index, static_cast<std::uint32_t>(frameEnds.size() - 1));
+    }
+
+    // Return clip itself if its timeline is current, otherwise a copy with the timeline built
+    static std::shared_ptr<const AnimationClip> WithTimeline(std::shared_ptr<const AnimationClip> clip) {
+        if (!clip || clip->HasTimeline()) return clip;
+
+        auto copy = std::make_shared<AnimationClip>(*clip);
+        copy->BuildTimeline();
+        return copy;
+    }
+};
+
+/**
+ * @brief Playback position within a clip
+ *
+ * This is all the per-instance data an animation needs; the frames live in
+ * a shared AnimationClip.
+ */
+struct AnimationState {
+    std::uint32_t clip = 0;    ///< Clip id in the owning AnimationSystem
+    std::uint32_t frame = 0;   ///< Index of the current frame
+    float time = 0.0f;         ///< Time since the start of the clip
+    bool playing = false;
+    bool ended = false;        ///< Clip reached its end or looped during the last AnimationSystem::Update()
+
+    void Restart() {
+        frame = 0;
+        time = 0.0f;
+        playing = true;
+        ended = false;
     }
 
-    void Pause() { isPlaying = false; }
-    void Resume() { isPlaying = true; }
     void Stop() {
-        isPlaying = false;
-        currentFrame = 0;
-        elapsedTime = 0.0f;
+        frame = 0;
+        time = 0.0f;
+        playing = false;
+        ended = false;
     }
 
-    void Update(float deltaTime) {
-        if (!isPlaying || frames.empty()) return;
-
-        elapsedTime += deltaTime;
-        if (elapsedTime >= frames[currentFrame].duration) {
-            elapsedTime -= frames[currentFrame].duration;
-            
-            if (currentFrame + 1 >= frames.size()) {
-                if (looping) {
-                    currentFrame = 0;
-                } else {
-                    isPlaying = false;
-                    elapsedTime = 0.0f;
-                }
+    /**
+     * @brief Jump to a time in the clip without firing frame events
+     * @param seekTime Seconds from the start; wrapped for looping clips, clamped otherwise
+     */
+    void Seek(const AnimationClip& data, float seekTime) {
+        const float duration = data.GetDuration();
+        if (duration <= 0.0f) {
+            time = 0.0f;
+            frame = 0;
+            return;
+        }
+
+        if (data.looping) {
+            seekTime = std::fmod(seekTime, duration);
+            if (seekTime < 0.0f) seekTime += duration;
+        } else {
+            seekTime = std::clamp(seekTime, 0.0f, duration);
+        }
+        time = seekTime;
+        frame = data.FindFrame(time);
+    }
+
+    /**
+     * @brief Advance playback by deltaTime, however many frames that crosses
+     * @param data Clip being played; its timeline must be built
+     * @param onFrame Called with the index of every frame entered, in order,
+     *        including frames skipped over by a large deltaTime. A delta
+     *        spanning several loops reports at most one full loop of frames.
+     * @return True if a looping clip wrapped around or a non-looping one reached its end
+     */
+    template <typename OnFrame>
+    bool Advance(const AnimationClip& data, float deltaTime, OnFrame&& onFrame) {
+        if (!playing || data.frames.empty() || deltaTime <= 0.0f) return false;
+
+        const float duration = data.GetDuration();
+        const auto frameCount = static_cast<std::uint32_t>(data.frames.size());
+        float newTime = time + deltaTime;
+        bool wrapped = false;
+        bool finished = false;
+
+        if (newTime >= duration) {
+            if (data.looping && duration > 0.0f) {
+                wrapped = true;
+                newTime = std::fmod(newTime, duration);
             } else {
-                currentFrame++;
+                newTime = duration;
+                finished = true;
             }
         }
+
+        const std::uint32_t newFrame = finished ? frameCount - 1 : data.FindFrame(newTime);
+        const std::uint32_t steps = (wrapped ? frameCount : 0) + newFrame - frame;
+        for (std::uint32_t i = 1; i <= steps; ++i) {
+            onFrame((frame + i) % frameCount);
+        }
+
+        time = newTime;
+        frame = newFrame;
+        if (finished) {
+            playing = false;
+        }
+        return wrapped || finished;
     }
 
+    bool Advance(const AnimationClip& data, float deltaTime) {
+        return Advance(data, deltaTime, [](std::uint32_t) {});
+    }
+};
+
+/**
+ * @brief Represents a complete animation sequence
+ *
+ * Convenient for a handful of objects. Large numbers of identical animated
+ * entities should use AnimationSystem, which stores only an AnimationState
+ * per entity and updates them all in one pass.
+ */
+class Animation {
+public:
+    using Frame = AnimationClip::Frame;
+    using FrameCallback = std::function<void(std::uint32_t frame)>;
+
+    // Default constructor
+    Animation() : name(""), looping(true) {}
+
+    Animation(const std::string& name, bool looping = true)
+        : name(name), looping(looping) {
+        ownClip.looping = looping;
+    }
+
+    // Play a shared clip, e.g. one loaded from a SpriteSheet, without copying its frames
+    explicit Animation(std::shared_ptr<const AnimationClip> clip)
+        : name(clip->name), looping(clip->looping), clip(AnimationClip::WithTimeline(std::move(clip))) {}
+
+    void AddFrame(const SDL_Rect& rect, float duration) {
+        // Shared clips are never modified; take a private copy of the frames
+        if (clip) {
+            ownClip = *clip;
+            clip = nullptr;
+        }
+        ownClip.AddFrame(rect, duration);
+    }
+
+    void Play() { state.Restart(); }
+    void Pause() { state.playing = false; }
+    void Resume() { state.playing = true; }
+    void Stop() { state.Stop(); }
+
+    // Jump to a time in the animation; frame callbacks are not called
+    void Seek(float time) { state.Seek(GetClipData(), time); }
+
+    void Update(float deltaTime) {
+        if (onFrame) {
+            state.Advance(GetClipData(), deltaTime, onFrame);
+        } else {
+            state.Advance(GetClipData(), deltaTime);
+        }
+    }
+
+    // Called for every frame entered during Update(), including skipped ones
+    void SetFrameCallback(FrameCallback callback) { onFrame = std::move(callback); }
+
     const Frame& GetCurrentFrame() const {
-        return frames[currentFrame];
+        return GetFrames()[state.frame];
     }
 
-    bool IsPlaying() const { return isPlaying; }
+    std::uint32_t GetCurrentFrameIndex() const { return state.frame; }
+    float GetTime() const { return state.time; }
+    float GetDuration() const { return GetClipData().GetDuration(); }
+
+    const std::vector<Frame>& GetFrames() const { return GetClipData().frames; }
+
+    // Shared clip being played, or nullptr if the frames were added with AddFrame()
+    const std::shared_ptr<const AnimationClip>& GetClip() const { return clip; }
+
+    bool IsPlaying() const { return state.playing; }
     bool IsLooping() const { return looping; }
     const std::string& GetName() const { return name; }
 
 private:
+    const AnimationClip& GetClipData() const { return clip ? *clip : ownClip; }
+
     std::string name;
-    std::vector<Frame> frames;
+    AnimationClip ownClip;  ///< Own frames, used when clip is null
     bool looping;
-    size_t currentFrame;
-    float elapsedTime;
-    bool isPlaying;
+    AnimationState state;
+    std::shared_ptr<const AnimationClip> clip;
+    FrameCallback onFrame;
 };
 
 /**
  * @brief Component that manages sprite animations
+ *
+ * Animations are numbered in the order they are added. Look ids up once
+ * with FindAnimation() and play by id to avoid hashing names every frame.
  */
 class AnimationController {
 public:
-    void AddAnimation(const std::string& name, bool looping = true) {
-        animations[name] = Animation(name, looping);
+    using AnimationId = int;
+    static constexpr AnimationId kInvalidAnimation = -1;
+
+    AnimationId AddAnimation(const std::string& name, bool looping = true) {
+        return Add(Animation(name, looping));
+    }
+
+    AnimationId AddAnimation(std::shared_ptr<const AnimationClip> clip) {
+        return Add(Animation(std::move(clip)));
+    }
+
+    /**
+     * @brief Add every clip of a sprite sheet, sharing their frame data
+     * @param clips Clips, e.g. SpriteSheet::GetClips()
+     * @return Id of the first clip, or kInvalidAnimation if there are none
+     *
+     * A clip named like an existing animation, or like an earlier clip,
+     * replaces that animation and takes its id. Only when every name is new
+     * does clip i get the returned id + i; otherwise use FindAnimation().
+     */
+    AnimationId AddClips(const std::vector<std::shared_ptr<const AnimationClip>>& clips) {
+        AnimationId first = kInvalidAnimation;
+        for (const auto& clip : clips) {
+            const AnimationId id = AddAnimation(clip);
+            if (first == kInvalidAnimation) first = id;
+        }
+        return first;
+    }
+
+    AnimationId FindAnimation(const std::string& name) const {
+        auto it = ids.find(name);
+        return it != ids.end() ? it->second : kInvalidAnimation;
+    }
+
+    Animation* GetAnimation(AnimationId id) {
+        return id >= 0 && static_cast<size_t>(id) < animations.size() ? &animations[id] : nullptr;
     }
 
     Animation* GetAnimation(const std::string& name) {
-        auto it = animations.find(name);
-        return it != animations.end() ? &it->second : nullptr;
+        return GetAnimation(FindAnimation(name));
     }
 
-    void Play(const std::string& name) {
-        if (currentAnimation && currentAnimation->GetName() == name) return;
+    void Play(AnimationId id) {
+        if (currentAnimation && currentAnimation == GetAnimation(id)) return;
         
-        auto* anim = GetAnimation(name);
+        auto* anim = GetAnimation(id);
         if (anim) {
             if (currentAnimation) {
                 currentAnimation->Stop();
@@ -114,6 +320,10 @@ public:
         }
     }
 
+    void Play(const std::string& name) {
+        Play(FindAnimation(name));
+    }
+
     void Stop() {
         if (currentAnimation) {
             currentAnimation->Stop();
@@ -132,6 +342,19 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, Animation> animations;
+    AnimationId Add(Animation animation) {
+        // Adding a name again replaces that animation, keeping its id
+        auto [it, inserted] = ids.try_emplace(animation.GetName(), static_cast<AnimationId>(animations.size()));
+        if (!inserted) {
+            animations[it->second] = std::move(animation);
+            return it->second;
+        }
+
+        animations.push_back(std::move(animation));
+        return it->second;
+    }
+
+    std::deque<Animation> animations;  ///< Indexed by id; deque keeps pointers stable
+    std::unordered_map<std::string, AnimationId> ids;
     Animation* currentAnimation = nullptr;
 };
@@ -0,0 +1,75 @@
+#include "animationstatemachine.h"
+
+AnimationStateMachine::StateId AnimationStateMachine::AddState(const std::string& name, std::uint32_t clip) {
+    const auto id = static_cast<StateId>(states.size());
+    states.push_back({name, clip});
+    transitions.emplace_back();
+    stateIds.emplace(name, id);
+    return id;
+}
+
+AnimationStateMachine::ParameterId AnimationStateMachine::AddParameter(const std::string& name, float defaultValue,
+                                                                       bool trigger) {
+    const auto id = static_cast<ParameterId>(parameters.size());
+    parameters.push_back({name, defaultValue, trigger});
+    parameterIds.emplace(name, id);
+    return id;
+}
+
+void AnimationStateMachine::AddTransition(Transition transition) {
+    if (transition.to >= states.size()) return;
+
+    if (transition.from == kAnyState) {
+        anyStateTransitions.push_back(std::move(transition));
+    } else if (transition.from < states.size()) {
+        transitions[transition.from].push_back(std::move(transition));
+    }
+}
+
+const AnimationStateMachine::Transition* AnimationStateMachine::FindTransition(StateId current,
+                                                                               const float* values,
+                                                                               bool finished) const {
+    if (current >= states.size()) return nullptr;
+
+    for (const Transition& transition : transitions[current]) {
+        if (ConditionsHold(transition, values, finished)) {
+            return &transition;
+        }
+    }
+    for (const Transition& transition : anyStateTransitions) {
+        // Don't restart the current state from itself every frame
+        if (transition.to != current && ConditionsHold(transition, values, finished)) {
+            return &transition;
+        }
+    }
+    return nullptr;
+}
+
+bool AnimationStateMachine::ConditionsHold(const Transition& transition, const float* values, bool finished) const {
+    if (transition.onFinish && !finished) return false;
+
+    for (const Condition& condition : transition.conditions) {
+        if (condition.parameter >= parameters.size()) return false;
+
+        const float value = values[condition.parameter];
+        bool holds = false;
+        switch (condition.compare) {
+            case Compare::Greater: holds = value > condition.value; break;
+            case Compare::Less: holds = value < condition.value; break;
+            case Compare::Equal: holds = value == condition.value; break;
+            case Compare::NotEqual: holds = value != condition.value; break;
+        }
+        if (!holds) return false;
+    }
+    return true;
+}
+
+AnimationStateMachine::StateId AnimationStateMachine::FindState(const std::string& name) const {
+    auto it = stateIds.find(name);
+    return it != stateIds.end() ? it->second : kInvalidState;
+}
+
+AnimationStateMachine::ParameterId AnimationStateMachine::FindParameter(const std::string& name) const {
+    auto it = parameterIds.find(name);
+    return it != parameterIds.end() ? it->second : kInvalidParameter;
+}
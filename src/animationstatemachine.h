@@ -0,0 +1,109 @@
+/**
+ * @file animationstatemachine.h
+ * @brief Shared definition of animation states and the transitions between them
+ *
+ * A state machine is built once and shared by every instance that runs it,
+ * like an AnimationClip. Each state plays a clip registered with the
+ * AnimationSystem; transitions fire when all their conditions on the
+ * instance's parameters hold, optionally only once the current clip has
+ * finished, and may ask for a crossfade from the old clip over a short
+ * time, which AnimationSystem::GetBlend() reports to the drawing code.
+ * Per-instance parameters and the current state live in the AnimationSystem.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AnimationStateMachine {
+public:
+    using StateId = std::uint32_t;
+    using ParameterId = std::uint32_t;
+    static constexpr StateId kInvalidState = 0xFFFFFFFFu;
+    static constexpr StateId kAnyState = 0xFFFFFFFEu;
+    static constexpr ParameterId kInvalidParameter = 0xFFFFFFFFu;
+
+    enum class Compare {
+        Greater,
+        Less,
+        Equal,
+        NotEqual
+    };
+
+    struct Condition {
+        ParameterId parameter;
+        Compare compare;
+        float value;
+    };
+
+    struct Transition {
+        StateId from;                         ///< Source state, or kAnyState
+        StateId to;
+        std::vector<Condition> conditions;    ///< All must hold
+        bool onFinish = false;                ///< Also wait for the current clip to finish or loop
+        float crossfade = 0.0f;               ///< Blend time from the old clip in seconds
+    };
+
+    struct State {
+        std::string name;
+        std::uint32_t clip;                   ///< Clip id in the AnimationSystem
+    };
+
+    struct Parameter {
+        std::string name;
+        float defaultValue;
+        bool trigger;                         ///< Reset to 0 when a transition uses it
+    };
+
+    /**
+     * @brief Add a state; the first one added is the entry state
+     * @param name Unique state name
+     * @param clip Clip id in the AnimationSystem the machine runs in
+     * @return Id of the state
+     */
+    StateId AddState(const std::string& name, std::uint32_t clip);
+
+    /**
+     * @brief Add a parameter that transitions can test
+     * @param name Unique parameter name
+     * @param defaultValue Value new instances start with; booleans use 0 and 1
+     * @param trigger Reset to 0 after a transition testing it fires
+     * @return Id of the parameter
+     */
+    ParameterId AddParameter(const std::string& name, float defaultValue = 0.0f, bool trigger = false);
+
+    /**
+     * @brief Add a transition
+     * Transitions from a state are tried in the order added, before
+     * transitions from kAnyState. Transitions to unknown states are ignored.
+     */
+    void AddTransition(Transition transition);
+
+    /**
+     * @brief Find the transition to take from a state
+     * @param current Current state
+     * @param parameters Parameter values of the instance, indexed by ParameterId
+     * @param finished Whether the current clip finished or looped this update
+     * @return The first transition whose conditions hold, or nullptr
+     */
+    [[nodiscard]] const Transition* FindTransition(StateId current, const float* parameters, bool finished) const;
+
+    [[nodiscard]] StateId FindState(const std::string& name) const;
+    [[nodiscard]] ParameterId FindParameter(const std::string& name) const;
+
+    [[nodiscard]] const State& GetState(StateId id) const { return states[id]; }
+    [[nodiscard]] const Parameter& GetParameter(ParameterId id) const { return parameters[id]; }
+    [[nodiscard]] size_t GetStateCount() const { return states.size(); }
+    [[nodiscard]] size_t GetParameterCount() const { return parameters.size(); }
+
+private:
+    bool ConditionsHold(const Transition& transition, const float* values, bool finished) const;
+
+    std::vector<State> states;
+    std::vector<Parameter> parameters;
+    std::vector<std::vector<Transition>> transitions;  ///< Outgoing transitions per state
+    std::vector<Transition> anyStateTransitions;
+    std::unordered_map<std::string, StateId> stateIds;
+    std::unordered_map<std::string, ParameterId> parameterIds;
+};
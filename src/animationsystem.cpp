@@ -0,0 +1,256 @@
+#include "animationsystem.h"
+
+AnimationSystem::ClipId AnimationSystem::AddClip(std::shared_ptr<const AnimationClip> clip) {
+    clips.push_back(AnimationClip::WithTimeline(std::move(clip)));
+    return static_cast<ClipId>(clips.size() - 1);
+}
+
+AnimationSystem::ClipId AnimationSystem::AddClips(const std::vector<std::shared_ptr<const AnimationClip>>& newClips) {
+    const auto first = static_cast<ClipId>(clips.size());
+    for (const auto& clip : newClips) {
+        clips.push_back(AnimationClip::WithTimeline(clip));
+    }
+    return first;
+}
+
+AnimationSystem::Handle AnimationSystem::Create(ClipId clip, bool play) {
+    if (clip >= clips.size()) {
+        return kInvalidHandle;
+    }
+
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(sparse.size());
+        sparse.push_back(kFreeSlot);
+    }
+
+    AnimationState state;
+    state.clip = clip;
+    state.playing = play;
+
+    sparse[handle] = static_cast<std::uint32_t>(states.size());
+    states.push_back(state);
+    denseHandles.push_back(handle);
+    return handle;
+}
+
+void AnimationSystem::Destroy(Handle handle) {
+    if (!IsValid(handle)) return;
+    DetachStateMachine(handle);
+
+    // Move the last state into the hole to keep the array dense
+    const std::uint32_t index = sparse[handle];
+    const Handle moved = denseHandles.back();
+    states[index] = states.back();
+    denseHandles[index] = moved;
+    sparse[moved] = index;
+
+    states.pop_back();
+    denseHandles.pop_back();
+    sparse[handle] = kFreeSlot;
+    freeHandles.push_back(handle);
+}
+
+void AnimationSystem::Play(Handle handle, ClipId clip) {
+    AnimationState* state = Find(handle);
+    if (!state || clip >= clips.size()) return;
+
+    state->clip = clip;
+    state->Restart();
+}
+
+void AnimationSystem::Pause(Handle handle) {
+    if (AnimationState* state = Find(handle)) {
+        state->playing = false;
+    }
+}
+
+void AnimationSystem::Resume(Handle handle) {
+    if (AnimationState* state = Find(handle)) {
+        state->playing = true;
+    }
+}
+
+void AnimationSystem::Stop(Handle handle) {
+    if (AnimationState* state = Find(handle)) {
+        state->Stop();
+    }
+}
+
+void AnimationSystem::Seek(Handle handle, float time) {
+    if (AnimationState* state = Find(handle)) {
+        state->Seek(*clips[state->clip], time);
+    }
+}
+
+const AnimationState* AnimationSystem::GetState(Handle handle) const {
+    return IsValid(handle) ? &states[sparse[handle]] : nullptr;
+}
+
+const AnimationClip::Frame* AnimationSystem::GetCurrentFrame(Handle handle) const {
+    const AnimationState* state = GetState(handle);
+    if (!state) return nullptr;
+
+    const AnimationClip& clip = *clips[state->clip];
+    return state->frame < clip.frames.size() ? &clip.frames[state->frame] : nullptr;
+}
+
+void AnimationSystem::Update(float deltaTime) {
+    for (size_t i = 0; i < states.size(); ++i) {
+        AnimationState& state = states[i];
+        state.ended = false;
+        if (!state.playing) continue;
+
+        const ClipId clip = state.clip;
+        if (frameCallback) {
+            const Handle handle = denseHandles[i];
+            state.ended = state.Advance(*clips[clip], deltaTime, [&](std::uint32_t frame) {
+                frameCallback(handle, clip, frame);
+            });
+        } else {
+            state.ended = state.Advance(*clips[clip], deltaTime);
+        }
+
+        if (!state.playing && finishedCallback) {
+            finishedCallback(denseHandles[i], clip);
+        }
+    }
+
+    if (!machineInstances.empty()) {
+        UpdateStateMachines(deltaTime);
+    }
+}
+
+void AnimationSystem::UpdateStateMachines(float deltaTime) {
+    for (MachineInstance& instance : machineInstances) {
+        AnimationState& state = states[sparse[instance.handle]];
+        const AnimationStateMachine& machine = *stateMachines[instance.machine];
+
+        if (instance.fadeDuration > 0.0f) {
+            instance.fadeElapsed += deltaTime;
+            if (instance.fadeElapsed >= instance.fadeDuration) {
+                instance.fadeDuration = 0.0f;
+            } else {
+                instance.fadeFrom.Advance(*clips[instance.fadeFrom.clip], deltaTime);
+            }
+        }
+
+        // A clip is finished once it reached its end, or looped during this update
+        const AnimationClip& clip = *clips[state.clip];
+        const bool finished = state.ended || (!clip.looping && state.time >= clip.GetDuration());
+
+        const auto* transition = machine.FindTransition(instance.state, instance.parameters.data(), finished);
+        if (transition) {
+            for (const auto& condition : transition->conditions) {
+                if (machine.GetParameter(condition.parameter).trigger) {
+                    instance.parameters[condition.parameter] = 0.0f;
+                }
+            }
+
+            if (transition->crossfade > 0.0f) {
+                instance.fadeFrom = state;
+                instance.fadeElapsed = 0.0f;
+                instance.fadeDuration = transition->crossfade;
+            }
+
+            const StateId from = instance.state;
+            instance.state = transition->to;
+            state.clip = machine.GetState(instance.state).clip;
+            state.Restart();
+
+            if (stateCallback) {
+                stateCallback(instance.handle, from, instance.state);
+            }
+        }
+    }
+}
+
+AnimationSystem::MachineId AnimationSystem::AddStateMachine(std::shared_ptr<const AnimationStateMachine> machine) {
+    stateMachines.push_back(std::move(machine));
+    return static_cast<MachineId>(stateMachines.size() - 1);
+}
+
+bool AnimationSystem::AttachStateMachine(Handle handle, MachineId id) {
+    AnimationState* state = Find(handle);
+    if (!state || id >= stateMachines.size()) return false;
+
+    const AnimationStateMachine& machine = *stateMachines[id];
+    if (machine.GetStateCount() == 0) return false;
+    for (size_t i = 0; i < machine.GetStateCount(); ++i) {
+        if (machine.GetState(static_cast<StateId>(i)).clip >= clips.size()) return false;
+    }
+
+    MachineInstance* instance = FindMachine(handle);
+    if (!instance) {
+        if (machineSlots.size() <= handle) {
+            machineSlots.resize(handle + 1, kFreeSlot);
+        }
+        machineSlots[handle] = static_cast<std::uint32_t>(machineInstances.size());
+        instance = &machineInstances.emplace_back();
+        instance->handle = handle;
+    }
+
+    instance->machine = id;
+    instance->state = 0;
+    instance->fadeDuration = 0.0f;
+    instance->parameters.resize(machine.GetParameterCount());
+    for (size_t i = 0; i < machine.GetParameterCount(); ++i) {
+        instance->parameters[i] = machine.GetParameter(static_cast<AnimationStateMachine::ParameterId>(i)).defaultValue;
+    }
+
+    state->clip = machine.GetState(0).clip;
+    state->Restart();
+    return true;
+}
+
+void AnimationSystem::DetachStateMachine(Handle handle) {
+    if (!FindMachine(handle)) return;
+
+    // Same swap-remove as Destroy()
+    const std::uint32_t index = machineSlots[handle];
+    const Handle moved = machineInstances.back().handle;
+    machineInstances[index] = std::move(machineInstances.back());
+    machineSlots[moved] = index;
+
+    machineInstances.pop_back();
+    machineSlots[handle] = kFreeSlot;
+}
+
+void AnimationSystem::SetParameter(Handle handle, AnimationStateMachine::ParameterId parameter, float value) {
+    MachineInstance* instance = FindMachine(handle);
+    if (instance && parameter < instance->parameters.size()) {
+        instance->parameters[parameter] = value;
+    }
+}
+
+float AnimationSystem::GetParameter(Handle handle, AnimationStateMachine::ParameterId parameter) const {
+    const MachineInstance* instance = FindMachine(handle);
+    return instance && parameter < instance->parameters.size() ? instance->parameters[parameter] : 0.0f;
+}
+
+AnimationSystem::StateId AnimationSystem::GetMachineState(Handle handle) const {
+    const MachineInstance* instance = FindMachine(handle);
+    return instance ? instance->state : AnimationStateMachine::kInvalidState;
+}
+
+AnimationSystem::Blend AnimationSystem::GetBlend(Handle handle) const {
+    const MachineInstance* instance = FindMachine(handle);
+    if (!instance || instance->fadeDuration <= 0.0f) return {};
+
+    const AnimationClip& clip = *clips[instance->fadeFrom.clip];
+    if (instance->fadeFrom.frame >= clip.frames.size()) return {};
+
+    return {&clip.frames[instance->fadeFrom.frame], 1.0f - instance->fadeElapsed / instance->fadeDuration};
+}
+
+void AnimationSystem::Clear() {
+    states.clear();
+    denseHandles.clear();
+    sparse.clear();
+    freeHandles.clear();
+    machineInstances.clear();
+    machineSlots.clear();
+}
@@ -0,0 +1,235 @@
+/**
+ * @file animationsystem.h
+ * @brief Batched playback of many animation instances over shared clips
+ *
+ * Clips are registered once and referenced by id. Each instance is only an
+ * AnimationState (16 bytes) kept in a contiguous array, so Update() walks
+ * memory linearly no matter how many entities are animated. Instances are
+ * addressed by handles that stay valid while others are created and
+ * destroyed; a destroyed handle may be reused by a later Create().
+ *
+ * Instances may also run an AnimationStateMachine, which picks their clip
+ * from parameters set by game code. Frame, finish and state changes are
+ * reported through callbacks during Update(), so nothing needs polling.
+ * The system does not draw instances; code drawing GetCurrentFrame() can
+ * use GetBlend() to apply transition crossfades.
+ */
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "animation.h"
+#include "animationstatemachine.h"
+
+class AnimationSystem {
+public:
+    using ClipId = std::uint32_t;
+    using Handle = std::uint32_t;
+    using MachineId = std::uint32_t;
+    using StateId = AnimationStateMachine::StateId;
+    using FrameCallback = std::function<void(Handle handle, ClipId clip, std::uint32_t frame)>;
+    using FinishedCallback = std::function<void(Handle handle, ClipId clip)>;
+    using StateCallback = std::function<void(Handle handle, StateId from, StateId to)>;
+
+    /**
+     * @brief Clip an instance is fading out of during a crossfade
+     */
+    struct Blend {
+        const AnimationClip::Frame* frame = nullptr;  ///< Frame of the old clip, nullptr if not blending
+        float weight = 0.0f;                          ///< Weight of the old frame; the current one gets 1 - weight
+    };
+    static constexpr Handle kInvalidHandle = 0xFFFFFFFFu;
+
+    /**
+     * @brief Register a clip for instances to play
+     * @param clip Shared clip, e.g. from SpriteSheet::GetClip()
+     * @return Id of the clip
+     */
+    ClipId AddClip(std::shared_ptr<const AnimationClip> clip);
+
+    /**
+     * @brief Register several clips at once
+     * @param clips Clips, e.g. SpriteSheet::GetClips()
+     * @return Id of the first clip; clip i gets the returned id + i
+     */
+    ClipId AddClips(const std::vector<std::shared_ptr<const AnimationClip>>& clips);
+
+    [[nodiscard]] const AnimationClip* GetClip(ClipId id) const {
+        return id < clips.size() ? clips[id].get() : nullptr;
+    }
+
+    [[nodiscard]] size_t GetClipCount() const { return clips.size(); }
+
+    /**
+     * @brief Create an animation instance
+     * @param clip Clip to play
+     * @param play Start playing immediately
+     * @return Handle of the instance, or kInvalidHandle if the clip id is unknown
+     */
+    Handle Create(ClipId clip, bool play = true);
+
+    /**
+     * @brief Destroy an instance; its handle becomes invalid
+     */
+    void Destroy(Handle handle);
+
+    [[nodiscard]] bool IsValid(Handle handle) const {
+        return handle < sparse.size() && sparse[handle] != kFreeSlot;
+    }
+
+    /**
+     * @brief Switch an instance to a clip and restart it
+     */
+    void Play(Handle handle, ClipId clip);
+
+    void Pause(Handle handle);
+    void Resume(Handle handle);
+    void Stop(Handle handle);
+
+    /**
+     * @brief Jump an instance to a time in its clip without firing frame events
+     */
+    void Seek(Handle handle, float time);
+
+    /**
+     * @brief Set the function called for every frame an instance enters during Update()
+     *
+     * Frames skipped over by a large deltaTime are reported too. The callback
+     * must not create or destroy instances.
+     */
+    void SetFrameCallback(FrameCallback callback) { frameCallback = std::move(callback); }
+
+    /**
+     * @brief Set the function called when a non-looping clip reaches its end
+     */
+    void SetFinishedCallback(FinishedCallback callback) { finishedCallback = std::move(callback); }
+
+    /**
+     * @brief Register a state machine for instances to run
+     * @return Id of the state machine
+     */
+    MachineId AddStateMachine(std::shared_ptr<const AnimationStateMachine> machine);
+
+    /**
+     * @brief Let a state machine drive an instance, starting in its entry state
+     * @return False if the handle or machine is invalid or the machine has no states
+     */
+    bool AttachStateMachine(Handle handle, MachineId machine);
+
+    /**
+     * @brief Stop a state machine from driving an instance; its current clip keeps playing
+     */
+    void DetachStateMachine(Handle handle);
+
+    /**
+     * @brief Set a parameter of an instance's state machine
+     * Transitions are evaluated in the next Update().
+     */
+    void SetParameter(Handle handle, AnimationStateMachine::ParameterId parameter, float value);
+
+    /**
+     * @brief Set a trigger parameter to 1 until a transition consumes it
+     */
+    void SetTrigger(Handle handle, AnimationStateMachine::ParameterId parameter) {
+        SetParameter(handle, parameter, 1.0f);
+    }
+
+    [[nodiscard]] float GetParameter(Handle handle, AnimationStateMachine::ParameterId parameter) const;
+
+    /**
+     * @brief Get the state machine state of an instance
+     * @return The state, or kInvalidState if no state machine drives the instance
+     */
+    [[nodiscard]] StateId GetMachineState(Handle handle) const;
+
+    /**
+     * @brief Set the function called when a state machine changes state
+     */
+    void SetStateCallback(StateCallback callback) { stateCallback = std::move(callback); }
+
+    /**
+     * @brief Get the clip an instance is crossfading out of
+     *
+     * Only tracks the fade; nothing draws it unless the caller draws the old
+     * frame with the returned weight alongside GetCurrentFrame().
+     */
+    [[nodiscard]] Blend GetBlend(Handle handle) const;
+
+    /**
+     * @brief Get the playback state of an instance
+     * @return The state, or nullptr for an invalid handle
+     */
+    [[nodiscard]] const AnimationState* GetState(Handle handle) const;
+
+    /**
+     * @brief Get the frame an instance currently shows
+     * @return The frame, or nullptr for an invalid handle or an empty clip
+     */
+    [[nodiscard]] const AnimationClip::Frame* GetCurrentFrame(Handle handle) const;
+
+    /**
+     * @brief Advance every playing instance, then every state machine
+     *
+     * Callbacks are called from here and must not create or destroy instances.
+     * @param deltaTime Time elapsed since last update in seconds
+     */
+    void Update(float deltaTime);
+
+    [[nodiscard]] size_t GetInstanceCount() const { return states.size(); }
+
+    /**
+     * @brief Destroy all instances; registered clips and state machines are kept
+     */
+    void Clear();
+
+private:
+    static constexpr std::uint32_t kFreeSlot = 0xFFFFFFFFu;
+
+    AnimationState* Find(Handle handle) {
+        return IsValid(handle) ? &states[sparse[handle]] : nullptr;
+    }
+
+    /**
+     * @brief State machine data of one instance
+     */
+    struct MachineInstance {
+        Handle handle;
+        MachineId machine;
+        StateId state;
+        AnimationState fadeFrom;        ///< Clip being faded out
+        float fadeElapsed = 0.0f;
+        float fadeDuration = 0.0f;      ///< Zero when not crossfading
+        std::vector<float> parameters;
+    };
+
+    MachineInstance* FindMachine(Handle handle) {
+        return handle < machineSlots.size() && machineSlots[handle] != kFreeSlot
+            ? &machineInstances[machineSlots[handle]] : nullptr;
+    }
+
+    const MachineInstance* FindMachine(Handle handle) const {
+        return const_cast<AnimationSystem*>(this)->FindMachine(handle);
+    }
+
+    /**
+     * @brief Take transitions and advance crossfades of every state machine
+     */
+    void UpdateStateMachines(float deltaTime);
+
+    std::vector<std::shared_ptr<const AnimationClip>> clips;
+    std::vector<std::shared_ptr<const AnimationStateMachine>> stateMachines;
+    FrameCallback frameCallback;
+    FinishedCallback finishedCallback;
+    StateCallback stateCallback;
+
+    // State machines of the instances that have one, dense like states
+    std::vector<MachineInstance> machineInstances;
+    std::vector<std::uint32_t> machineSlots;  ///< Index in machineInstances per handle, or kFreeSlot
+
+    // Sparse set: handles index sparse, which indexes the dense arrays
+    std::vector<AnimationState> states;   ///< Dense, updated in one pass
+    std::vector<Handle> denseHandles;     ///< Handle of each dense state
+    std::vector<std::uint32_t> sparse;    ///< Dense index per handle, or kFreeSlot
+    std::vector<Handle> freeHandles;
+};
@@ -0,0 +1,231 @@
+/**
+ * @file asset-cache.h
+ * @brief Keyed asset cache with memory accounting and LRU eviction
+ *
+ * Every entry records an approximate size in bytes. When the total exceeds
+ * the budget, entries are evicted least recently used first, but only if the
+ * cache holds the last reference to them; assets still in use elsewhere are
+ * never freed from under their users and are retried on the next Trim().
+ *
+ * Entries are keyed by interned AssetId, so lookups index a vector.
+ */
+#pragma once
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "asset-id.h"
+
+template<typename T>
+class AssetCache {
+public:
+    // Counters describing cache effectiveness and memory use
+    struct Stats {
+        size_t hits = 0;           ///< Lookups that found a cached asset
+        size_t misses = 0;         ///< Lookups that had to load
+        size_t evictions = 0;      ///< Assets freed to stay within budget
+        size_t bytesResident = 0;  ///< Approximate memory held by cached assets
+        size_t budgetBytes = 0;    ///< Configured budget (0 = unlimited)
+        size_t assetCount = 0;     ///< Number of cached assets
+
+        [[nodiscard]] float GetHitRate() const {
+            size_t lookups = hits + misses;
+            return lookups > 0 ? static_cast<float>(hits) / lookups : 0.0f;
+        }
+    };
+
+    /**
+     * @brief Look up an asset and mark it as recently used
+     * Counts as a hit or a miss in the stats.
+     * @param key Asset key
+     * @return Cached asset, or nullptr if not cached
+     */
+    std::shared_ptr<T> Find(AssetId key) {
+        const Slot* slot = GetSlot(key);
+        if (!slot) {
+            ++stats.misses;
+            return nullptr;
+        }
+
+        ++stats.hits;
+        entries.splice(entries.begin(), entries, slot->entry);
+        return slot->entry->asset;
+    }
+
+    /**
+     * @brief Look up an asset without touching recency or stats
+     * @param key Asset key
+     * @return Cached asset, or nullptr if not cached
+     */
+    [[nodiscard]] std::shared_ptr<T> Peek(AssetId key) const {
+        const Slot* slot = GetSlot(key);
+        return slot ? slot->entry->asset : nullptr;
+    }
+
+    [[nodiscard]] bool Contains(AssetId key) const {
+        return GetSlot(key) != nullptr;
+    }
+
+    /**
+     * @brief Add an asset as the most recently used entry
+     * If the key is already cached the existing asset is kept and returned.
+     * @param key Asset key
+     * @param asset Asset to cache
+     * @param bytes Approximate memory used by the asset
+     * @return The cached asset for key
+     */
+    std::shared_ptr<T> Insert(AssetId key, std::shared_ptr<T> asset, size_t bytes) {
+        if (const Slot* slot = GetSlot(key)) {
+            return slot->entry->asset;
+        }
+
+        if (ToIndex(key) >= index.size()) {
+            index.resize(ToIndex(key) + 1);
+        }
+        entries.push_front(Entry{key, std::move(asset), bytes});
+        index[ToIndex(key)] = Slot{entries.begin(), true};
+        stats.bytesResident += bytes;
+
+        // Hold an extra reference so the new asset itself is never evicted here
+        std::shared_ptr<T> inserted = entries.front().asset;
+        Trim();
+        return inserted;
+    }
+
+    /**
+     * @brief Swap in a new asset for a cached key, keeping its recency
+     * Holders of the previous asset keep it until they release it.
+     * @param key Asset key
+     * @param asset New asset
+     * @param bytes Approximate memory used by the new asset
+     * @return False if the key is not cached
+     */
+    bool Replace(AssetId key, std::shared_ptr<T> asset, size_t bytes) {
+        const Slot* slot = GetSlot(key);
+        if (!slot) return false;
+
+        stats.bytesResident = stats.bytesResident - slot->entry->bytes + bytes;
+        slot->entry->asset = std::move(asset);
+        slot->entry->bytes = bytes;
+        return true;
+    }
+
+    /**
+     * @brief Remove an asset from the cache
+     * @param key Asset key
+     * @return True if the asset was cached
+     */
+    bool Erase(AssetId key) {
+        Slot* slot = GetSlot(key);
+        if (!slot) return false;
+
+        stats.bytesResident -= slot->entry->bytes;
+        entries.erase(slot->entry);
+        slot->cached = false;
+        return true;
+    }
+
+    /**
+     * @brief Evict unreferenced assets, least recently used first, until within budget
+     */
+    void Trim() {
+        if (stats.budgetBytes == 0) return;
+
+        for (auto it = entries.end(); it != entries.begin() && stats.bytesResident > stats.budgetBytes;) {
+            --it;
+            if (it->asset.use_count() == 1) {
+                stats.bytesResident -= it->bytes;
+                ++stats.evictions;
+                index[ToIndex(it->key)].cached = false;
+                it = entries.erase(it);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove entries the cache holds the last reference to
+     * @param pred Called with each such key; the entry is removed if it returns true
+     * @return Number of entries removed
+     */
+    template<typename Pred>
+    size_t EraseUnreferenced(Pred&& pred) {
+        size_t erased = 0;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->asset.use_count() == 1 && pred(it->key)) {
+                stats.bytesResident -= it->bytes;
+                index[ToIndex(it->key)].cached = false;
+                it = entries.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+        return erased;
+    }
+
+    /**
+     * @brief Set the memory budget and evict down to it
+     * @param bytes Budget in bytes, or 0 for unlimited
+     */
+    void SetBudget(size_t bytes) {
+        stats.budgetBytes = bytes;
+        Trim();
+    }
+
+    [[nodiscard]] bool IsOverBudget() const {
+        return stats.budgetBytes > 0 && stats.bytesResident > stats.budgetBytes;
+    }
+
+    void Clear() {
+        entries.clear();
+        index.clear();
+        stats.bytesResident = 0;
+    }
+
+    void ResetStats() {
+        stats.hits = 0;
+        stats.misses = 0;
+        stats.evictions = 0;
+    }
+
+    [[nodiscard]] Stats GetStats() const {
+        Stats result = stats;
+        result.assetCount = entries.size();
+        return result;
+    }
+
+    [[nodiscard]] size_t Size() const { return entries.size(); }
+
+    // Call fn(key, asset) for every entry, most recently used first
+    template<typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (const auto& entry : entries) {
+            fn(entry.key, entry.asset);
+        }
+    }
+
+private:
+    struct Entry {
+        AssetId key;
+        std::shared_ptr<T> asset;
+        size_t bytes;
+    };
+
+    struct Slot {
+        typename std::list<Entry>::iterator entry;
+        bool cached = false;
+    };
+
+    Slot* GetSlot(AssetId key) {
+        return ToIndex(key) < index.size() && index[ToIndex(key)].cached ? &index[ToIndex(key)] : nullptr;
+    }
+
+    const Slot* GetSlot(AssetId key) const {
+        return ToIndex(key) < index.size() && index[ToIndex(key)].cached ? &index[ToIndex(key)] : nullptr;
+    }
+
+    std::list<Entry> entries;  ///< Most recently used first
+    std::vector<Slot> index;   ///< Indexed by AssetId
+    Stats stats;
+};
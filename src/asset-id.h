@@ -0,0 +1,74 @@
+/**
+ * @file asset-id.h
+ * @brief Interned asset paths
+ *
+ * Every distinct asset path is assigned a small integer id once. Code that
+ * loads or plays the same asset repeatedly keeps the id and skips building
+ * and hashing the path string; caches indexed by id are plain vector lookups.
+ * Ids are never reused, so an id stays valid after its asset is unloaded.
+ */
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+enum class AssetId : std::uint32_t {
+    Invalid = 0xFFFFFFFFu
+};
+
+// Convert an id to a vector index
+constexpr size_t ToIndex(AssetId id) { return static_cast<size_t>(id); }
+
+class AssetPathTable {
+public:
+    AssetPathTable() = default;
+
+    // Views in the lookup map point into the stored strings
+    AssetPathTable(const AssetPathTable&) = delete;
+    AssetPathTable& operator=(const AssetPathTable&) = delete;
+
+    /**
+     * @brief Get the id of a path, assigning a new one on first use
+     * @param path Asset path
+     * @return Id of the path
+     */
+    AssetId Intern(std::string_view path) {
+        auto it = ids.find(path);
+        if (it != ids.end()) {
+            return it->second;
+        }
+
+        const auto id = static_cast<AssetId>(paths.size());
+        const std::string& stored = paths.emplace_back(path);
+        ids.emplace(stored, id);
+        return id;
+    }
+
+    /**
+     * @brief Get the id of a path without assigning one
+     * @param path Asset path
+     * @return Id of the path, or AssetId::Invalid if it was never interned
+     */
+    [[nodiscard]] AssetId Find(std::string_view path) const {
+        auto it = ids.find(path);
+        return it != ids.end() ? it->second : AssetId::Invalid;
+    }
+
+    /**
+     * @brief Get the path of an id
+     * @param id Id returned by Intern()
+     * @return The path, or an empty string for an unknown id
+     */
+    [[nodiscard]] const std::string& GetPath(AssetId id) const {
+        static const std::string empty;
+        return ToIndex(id) < paths.size() ? paths[ToIndex(id)] : empty;
+    }
+
+    [[nodiscard]] size_t Size() const { return paths.size(); }
+
+private:
+    std::deque<std::string> paths;  ///< Indexed by id; deque keeps the strings in place
+    std::unordered_map<std::string_view, AssetId> ids;
+};
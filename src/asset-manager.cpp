@@ -1,70 +1,729 @@
 #include "asset-manager.h"
 
+#include <debug/metrics.h>
 #include <game.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+
+namespace {
+    size_t TextureBytes(SDL_Texture* texture) {
+        Uint32 format = 0;
+        int w = 0;
+        int h = 0;
+        if (SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) {
+            return 0;
+        }
+        return static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+    }
+
+    size_t ChunkBytes(const Mix_Chunk* chunk) {
+        return chunk->alen;
+    }
+}
 
 AssetManager& AssetManager::Instance() {
     static AssetManager instance;
     return instance;
 }
 
-std::shared_ptr<SDL_Texture> AssetManager::LoadTexture(const std::string& path) {
-    auto renderer = Game::Instance().GetRenderer();
-    auto it = textures.find(path);
-    if (it != textures.end()) {
-        return it->second;
+AssetManager::~AssetManager() {
+    // Join the watcher and workers before freeing anything they may still produce
+    fileWatcher.reset();
+    threadPool.reset();
+
+    for (auto& decoded : decodedAssets) {
+        if (decoded.surface) SDL_FreeSurface(decoded.surface);
+        if (decoded.chunk) Mix_FreeChunk(decoded.chunk);
     }
-    
-    SDL_Surface* surface = IMG_Load(path.c_str());
+}
+
+bool AssetManager::MountPack(const std::string& path, const std::string& mountPoint) {
+    std::shared_ptr<AssetPack> pack = AssetPack::Open(path);
+    if (!pack) {
+        return false;
+    }
+
+    std::string prefix = mountPoint;
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix += '/';
+    }
+
+    // Changing the pack file invalidates decoded textures cached from it
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+    std::uint64_t stamp = TextureDiskCache::Hash(path.data(), path.size());
+    stamp = TextureDiskCache::Hash(&modified, sizeof(modified), stamp);
+
+    std::unique_lock<std::shared_mutex> lock(packMutex);
+    packs.push_back(MountedPack{std::move(pack), std::move(prefix), stamp});
+    return true;
+}
+
+void AssetManager::UnmountPacks() {
+    std::unique_lock<std::shared_mutex> lock(packMutex);
+    packs.clear();
+}
+
+const AssetManager::MountedPack* AssetManager::FindInPacks(const std::string& path,
+                                                           const AssetPack::Entry*& entry) const {
+    // Packs mounted later override earlier ones
+    for (auto it = packs.rbegin(); it != packs.rend(); ++it) {
+        std::string_view name = path;
+        if (!it->prefix.empty()) {
+            if (name.compare(0, it->prefix.size(), it->prefix) != 0) continue;
+            name.remove_prefix(it->prefix.size());
+        }
+
+        entry = it->pack->Find(name);
+        if (entry) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+AssetManager::AssetSource AssetManager::OpenAsset(const std::string& path) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(packMutex);
+
+        const AssetPack::Entry* entry = nullptr;
+        if (const MountedPack* mounted = FindInPacks(path, entry)) {
+            if (entry->compression == AssetPack::Compression::None) {
+                return {SDL_RWFromConstMem(entry->data, static_cast<int>(entry->storedSize)), mounted->pack};
+            }
+
+            auto buffer = std::make_shared<std::vector<std::uint8_t>>();
+            if (!mounted->pack->Extract(*entry, *buffer)) {
+                return {};
+            }
+            return {SDL_RWFromConstMem(buffer->data(), static_cast<int>(buffer->size())), buffer};
+        }
+    }
+
+    return {SDL_RWFromFile(path.c_str(), "rb"), nullptr};
+}
+
+bool AssetManager::GetSourceStamp(const std::string& path, std::uint64_t& stamp) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(packMutex);
+
+        const AssetPack::Entry* entry = nullptr;
+        if (const MountedPack* mounted = FindInPacks(path, entry)) {
+            stamp = TextureDiskCache::Hash(&entry->size, sizeof(entry->size), mounted->stamp);
+            return true;
+        }
+    }
+
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+    if (error) return false;
+    auto size = std::filesystem::file_size(path, error);
+    if (error) return false;
+
+    stamp = TextureDiskCache::Hash(&modified, sizeof(modified));
+    stamp = TextureDiskCache::Hash(&size, sizeof(size), stamp);
+    return true;
+}
+
+bool AssetManager::DecodeTexture(const std::string& path, TextureDiskCache::Image& image,
+                                 SDL_Surface*& surface, std::string* error) const {
+    std::uint64_t stamp = 0;
+    const bool cacheable = textureDiskCache.IsEnabled() && GetSourceStamp(path, stamp);
+    if (cacheable && textureDiskCache.Load(path, stamp, image)) {
+        return true;
+    }
+    image = TextureDiskCache::Image();
+
+    surface = ReadSurface(path, error);
     if (!surface) {
+        return false;
+    }
+
+    if (cacheable && !textureDiskCache.Store(path, stamp, surface)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to cache decoded texture '%s'", path.c_str());
+    }
+    return true;
+}
+
+SDL_Surface* AssetManager::ReadSurface(const std::string& path, std::string* error) const {
+    AssetSource source = OpenAsset(path);
+    SDL_Surface* surface = source.rw ? IMG_Load_RW(source.rw, 1) : nullptr;
+    if (!surface && error) *error = IMG_GetError();
+    return surface;
+}
+
+Mix_Chunk* AssetManager::ReadChunk(const std::string& path, std::string* error) const {
+    AssetSource source = OpenAsset(path);
+    Mix_Chunk* chunk = source.rw ? Mix_LoadWAV_RW(source.rw, 1) : nullptr;
+    if (!chunk && error) *error = Mix_GetError();
+    return chunk;
+}
+
+std::shared_ptr<Mix_Music> AssetManager::ReadMusic(const std::string& path, size_t& bytes,
+                                                   std::string* error) const {
+    AssetSource source = OpenAsset(path);
+    if (!source.rw) {
+        if (error) *error = SDL_GetError();
+        return nullptr;
+    }
+
+    // Mix_Music is opaque; the encoded size is the best available estimate
+    Sint64 size = SDL_RWsize(source.rw);
+    bytes = size > 0 ? static_cast<size_t>(size) : 0;
+
+    Mix_Music* mus = Mix_LoadMUS_RW(source.rw, 1);
+    if (!mus) {
+        if (error) *error = Mix_GetError();
         return nullptr;
     }
+
+    // Music streams from its source while playing, so the source must outlive it
+    return std::shared_ptr<Mix_Music>(mus, [keepAlive = std::move(source.keepAlive)](Mix_Music* m) {
+        Mix_FreeMusic(m);
+    });
+}
+
+void AssetManager::Decode(DecodedAsset& decoded) const {
+    switch (decoded.type) {
+        case DecodedAsset::Type::Texture:
+            DecodeTexture(decoded.path, decoded.image, decoded.surface, &decoded.error);
+            break;
+        case DecodedAsset::Type::Sound:
+            decoded.chunk = ReadChunk(decoded.path, &decoded.error);
+            break;
+        case DecodedAsset::Type::Music:
+            decoded.music = ReadMusic(decoded.path, decoded.bytes, &decoded.error);
+            break;
+    }
+}
+
+std::shared_ptr<SDL_Texture> AssetManager::LoadTexture(AssetId id) {
+    if (auto cached = textures.Find(id)) {
+        return cached;
+    }
     
+    TextureDiskCache::Image image;
+    SDL_Surface* surface = nullptr;
+    if (!DecodeTexture(GetAssetPath(id), image, surface)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<SDL_Texture> shared_texture;
+    if (surface) {
+        shared_texture = CreateTexture(id, surface);
+        SDL_FreeSurface(surface);
+    } else {
+        shared_texture = CreateTexture(id, image);
+    }
+
+    if (shared_texture) {
+        WatchForReload(id);
+    }
+    return shared_texture;
+}
+
+std::shared_ptr<SDL_Texture> AssetManager::CreateTexture(AssetId id, const TextureDiskCache::Image& image) {
+    auto renderer = Game::Instance().GetRenderer();
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                             image.width, image.height);
+    if (!texture) {
+        return nullptr;
+    }
+
+    if (SDL_UpdateTexture(texture, nullptr, image.GetPixels(), image.GetPitch()) != 0) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    auto shared_texture = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
+    return textures.Insert(id, shared_texture, TextureBytes(texture));
+}
+
+std::shared_ptr<SDL_Texture> AssetManager::CreateTexture(AssetId id, SDL_Surface* surface) {
+    auto renderer = Game::Instance().GetRenderer();
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    
     if (!texture) {
         return nullptr;
     }
-    
+
     auto shared_texture = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
-    textures[path] = shared_texture;
-    return shared_texture;
+    return textures.Insert(id, shared_texture, TextureBytes(texture));
 }
 
-std::shared_ptr<Mix_Chunk> AssetManager::LoadSound(const std::string& path) {
-    auto it = sounds.find(path);
-    if (it != sounds.end()) {
-        return it->second;
+std::shared_ptr<Mix_Chunk> AssetManager::LoadSound(AssetId id) {
+    if (auto cached = sounds.Find(id)) {
+        return cached;
     }
     
-    Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
+    Mix_Chunk* chunk = ReadChunk(GetAssetPath(id));
     if (!chunk) {
         return nullptr;
     }
     
     auto shared_chunk = std::shared_ptr<Mix_Chunk>(chunk, Mix_FreeChunk);
-    sounds[path] = shared_chunk;
-    return shared_chunk;
+    WatchForReload(id);
+    return sounds.Insert(id, shared_chunk, ChunkBytes(chunk));
 }
 
-std::shared_ptr<Mix_Music> AssetManager::LoadMusic(const std::string& path) {
-    auto it = music.find(path);
-    if (it != music.end()) {
-        return it->second;
+std::shared_ptr<Mix_Music> AssetManager::LoadMusic(AssetId id) {
+    if (auto cached = music.Find(id)) {
+        return cached;
     }
     
-    Mix_Music* mus = Mix_LoadMUS(path.c_str());
-    if (!mus) {
+    size_t bytes = 0;
+    auto shared_music = ReadMusic(GetAssetPath(id), bytes);
+    if (!shared_music) {
         return nullptr;
     }
     
-    auto shared_music = std::shared_ptr<Mix_Music>(mus, Mix_FreeMusic);
-    music[path] = shared_music;
-    return shared_music;
+    WatchForReload(id);
+    return music.Insert(id, shared_music, bytes);
+}
+
+std::shared_ptr<SpriteSheet> AssetManager::LoadSpriteSheet(AssetId id) {
+    if (auto cached = spriteSheets.Find(id)) {
+        return cached;
+    }
+
+    const std::string& path = GetAssetPath(id);
+    AssetSource source = OpenAsset(path);
+    if (!source.rw) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open sprite sheet '%s': %s", path.c_str(), SDL_GetError());
+        return nullptr;
+    }
+
+    std::vector<char> data;
+    const Sint64 size = SDL_RWsize(source.rw);
+    if (size > 0) {
+        data.resize(static_cast<size_t>(size));
+        if (SDL_RWread(source.rw, data.data(), 1, data.size()) != data.size()) {
+            data.clear();
+        }
+    }
+    SDL_RWclose(source.rw);
+
+    std::string error = "empty or unreadable file";
+    auto sheet = data.empty() ? nullptr : SpriteSheet::FromMemory(data.data(), data.size(), &error);
+    if (!sheet) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load sprite sheet '%s': %s", path.c_str(), error.c_str());
+        return nullptr;
+    }
+
+    return spriteSheets.Insert(id, sheet, sheet->GetByteSize());
+}
+
+AssetManager::AssetFuture<SDL_Texture> AssetManager::LoadTextureAsync(
+    std::string_view path, AssetCallback<SDL_Texture> callback)
+{
+    return QueueLoad(GetAssetId(path), DecodedAsset::Type::Texture, textures, pendingTextures, std::move(callback));
+}
+
+AssetManager::AssetFuture<Mix_Chunk> AssetManager::LoadSoundAsync(
+    std::string_view path, AssetCallback<Mix_Chunk> callback)
+{
+    return QueueLoad(GetAssetId(path), DecodedAsset::Type::Sound, sounds, pendingSounds, std::move(callback));
+}
+
+AssetManager::AssetFuture<Mix_Music> AssetManager::LoadMusicAsync(
+    std::string_view path, AssetCallback<Mix_Music> callback)
+{
+    return QueueLoad(GetAssetId(path), DecodedAsset::Type::Music, music, pendingMusic, std::move(callback));
+}
+
+template<typename T>
+AssetManager::AssetFuture<T> AssetManager::QueueLoad(
+    AssetId id, DecodedAsset::Type type,
+    AssetCache<T>& cache,
+    std::unordered_map<AssetId, PendingLoad<T>>& pending,
+    AssetCallback<T> callback)
+{
+    if (auto cached = cache.Find(id)) {
+        std::promise<std::shared_ptr<T>> ready;
+        ready.set_value(cached);
+        if (callback) {
+            callback(cached);
+        }
+        return ready.get_future().share();
+    }
+
+    // Requests for a path that is already loading share the same decode
+    auto [it, inserted] = pending.try_emplace(id);
+    PendingLoad<T>& load = it->second;
+    if (callback) {
+        load.callbacks.push_back(std::move(callback));
+    }
+
+    if (inserted) {
+        load.future = load.promise.get_future().share();
+        QueueDecode(id, type, false);
+    }
+
+    return load.future;
+}
+
+void AssetManager::QueueDecode(AssetId id, DecodedAsset::Type type, bool reload) {
+    // The path table is main-thread only, so the worker gets its own copy
+    GetThreadPool().Submit([this, id, path = GetAssetPath(id), type, reload]() {
+        DecodedAsset decoded;
+        decoded.type = type;
+        decoded.id = id;
+        decoded.path = path;
+        decoded.reload = reload;
+        Decode(decoded);
+
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decodedAssets.push_back(std::move(decoded));
+    });
+}
+
+void AssetManager::ProcessPendingUploads(float budgetMs) {
+    TrimCaches();
+    QueueReloads();
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const auto budgetTicks = static_cast<Uint64>(budgetMs / 1000.0f * SDL_GetPerformanceFrequency());
+
+    for (;;) {
+        DecodedAsset decoded;
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex);
+            if (decodedAssets.empty()) return;
+            decoded = std::move(decodedAssets.front());
+            decodedAssets.pop_front();
+        }
+
+        FinishLoad(decoded);
+
+        if (SDL_GetPerformanceCounter() - start >= budgetTicks) return;
+    }
+}
+
+void AssetManager::FinishLoad(const DecodedAsset& decoded) {
+    if (!decoded.error.empty()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "Failed to load '%s': %s", decoded.path.c_str(), decoded.error.c_str());
+    }
+
+    if (decoded.reload) {
+        ApplyReload(decoded);
+        return;
+    }
+
+    switch (decoded.type) {
+        case DecodedAsset::Type::Texture: {
+            // CreateTexture() inserts into the cache itself
+            std::shared_ptr<SDL_Texture> texture = textures.Peek(decoded.id);
+            if (!texture && decoded.surface) {
+                texture = CreateTexture(decoded.id, decoded.surface);
+            } else if (!texture && !decoded.image.data.empty()) {
+                texture = CreateTexture(decoded.id, decoded.image);
+            }
+            if (decoded.surface) {
+                SDL_FreeSurface(decoded.surface);
+            }
+            Deliver(decoded.id, std::move(texture), 0, textures, pendingTextures);
+            break;
+        }
+        case DecodedAsset::Type::Sound: {
+            std::shared_ptr<Mix_Chunk> chunk;
+            size_t bytes = 0;
+            if (decoded.chunk) {
+                bytes = ChunkBytes(decoded.chunk);
+                chunk = std::shared_ptr<Mix_Chunk>(decoded.chunk, Mix_FreeChunk);
+            }
+            Deliver(decoded.id, std::move(chunk), bytes, sounds, pendingSounds);
+            break;
+        }
+        case DecodedAsset::Type::Music: {
+            Deliver(decoded.id, decoded.music, decoded.bytes, music, pendingMusic);
+            break;
+        }
+    }
+}
+
+template<typename T>
+void AssetManager::Deliver(AssetId id, std::shared_ptr<T> asset, size_t bytes,
+                           AssetCache<T>& cache,
+                           std::unordered_map<AssetId, PendingLoad<T>>& pending)
+{
+    if (asset) {
+        // A synchronous load may have finished first; keep a single instance
+        asset = cache.Insert(id, std::move(asset), bytes);
+        WatchForReload(id);
+    }
+
+    auto it = pending.find(id);
+    if (it == pending.end()) return;
+
+    PendingLoad<T> load = std::move(it->second);
+    pending.erase(it);
+
+    load.promise.set_value(asset);
+    for (const auto& callback : load.callbacks) {
+        try {
+            callback(asset);
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "Error in asset load callback for '%s': %s", GetAssetPath(id).c_str(), e.what());
+        }
+    }
+}
+
+size_t AssetManager::GetPendingLoadCount() const {
+    return pendingTextures.size() + pendingSounds.size() + pendingMusic.size();
+}
+
+ThreadPool& AssetManager::GetThreadPool() {
+    if (!threadPool) {
+        threadPool = std::make_unique<ThreadPool>();
+    }
+    return *threadPool;
+}
+
+void AssetManager::SetHotReloadEnabled(bool enabled) {
+    if (enabled == IsHotReloadEnabled()) return;
+
+    if (!enabled) {
+        fileWatcher.reset();
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        changedFiles.clear();
+        return;
+    }
+
+    fileWatcher = std::make_unique<FileWatcher>([this](const std::string& path) {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        changedFiles.push_back(path);
+    });
+
+    // Assets loaded before hot reload was enabled
+    auto watch = [this](AssetId id, const auto&) { WatchForReload(id); };
+    textures.ForEach(watch);
+    sounds.ForEach(watch);
+    music.ForEach(watch);
+}
+
+void AssetManager::WatchForReload(AssetId id) {
+    if (!fileWatcher) return;
+
+    const std::string& path = GetAssetPath(id);
+    {
+        // Packs are immutable while mounted
+        std::shared_lock<std::shared_mutex> lock(packMutex);
+        const AssetPack::Entry* entry = nullptr;
+        if (FindInPacks(path, entry)) return;
+    }
+
+    fileWatcher->Watch(path);
+}
+
+void AssetManager::QueueReloads() {
+    std::vector<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        changed.swap(changedFiles);
+    }
+
+    // Editors often write a file several times when saving; reload it once
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    for (const auto& path : changed) {
+        const AssetId id = assetPaths.Find(path);
+        if (textures.Contains(id)) {
+            QueueDecode(id, DecodedAsset::Type::Texture, true);
+        } else if (sounds.Contains(id)) {
+            QueueDecode(id, DecodedAsset::Type::Sound, true);
+        } else if (music.Contains(id)) {
+            QueueDecode(id, DecodedAsset::Type::Music, true);
+        } else if (fileWatcher) {
+            // Evicted or cleared since it was loaded
+            fileWatcher->Unwatch(path);
+        }
+    }
+}
+
+void AssetManager::ApplyReload(const DecodedAsset& decoded) {
+    switch (decoded.type) {
+        case DecodedAsset::Type::Texture: {
+            SDL_Surface* source = decoded.surface;
+            if (!source && !decoded.image.data.empty()) {
+                // Wrap the disk cache pixels without copying them
+                source = SDL_CreateRGBSurfaceWithFormatFrom(
+                    const_cast<void*>(decoded.image.GetPixels()), decoded.image.width, decoded.image.height,
+                    32, decoded.image.GetPitch(), SDL_PIXELFORMAT_RGBA32);
+            }
+            if (!source) break;
+
+            std::shared_ptr<SDL_Texture> texture = textures.Peek(decoded.id);
+            Uint32 format = 0;
+            int w = 0;
+            int h = 0;
+            bool updated = false;
+            if (texture && SDL_QueryTexture(texture.get(), &format, nullptr, &w, &h) == 0 &&
+                w == source->w && h == source->h) {
+                // Same size: update the pixels so every holder sees the change
+                if (SDL_Surface* converted = SDL_ConvertSurfaceFormat(source, format, 0)) {
+                    updated = SDL_UpdateTexture(texture.get(), nullptr, converted->pixels, converted->pitch) == 0;
+                    SDL_FreeSurface(converted);
+                }
+            }
+
+            if (texture && !updated) {
+                // Textures cannot be resized; only later loads get the new one
+                SDL_Texture* replacement = SDL_CreateTextureFromSurface(Game::Instance().GetRenderer(), source);
+                if (replacement) {
+                    textures.Replace(decoded.id, std::shared_ptr<SDL_Texture>(replacement, SDL_DestroyTexture),
+                                     TextureBytes(replacement));
+                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "Reloaded texture '%s' changed size; existing users keep the old texture",
+                        decoded.path.c_str());
+                }
+            }
+
+            SDL_FreeSurface(source);
+            break;
+        }
+        case DecodedAsset::Type::Sound: {
+            std::shared_ptr<Mix_Chunk> chunk = sounds.Peek(decoded.id);
+            if (!chunk || !decoded.chunk) {
+                if (decoded.chunk) Mix_FreeChunk(decoded.chunk);
+                break;
+            }
+
+            // Stop channels still reading the old samples before freeing them
+            const int channels = Mix_AllocateChannels(-1);
+            for (int channel = 0; channel < channels; ++channel) {
+                if (Mix_GetChunk(channel) == chunk.get()) {
+                    Mix_HaltChannel(channel);
+                }
+            }
+
+            // Move the new samples into the existing chunk so every holder
+            // plays them; the decoded chunk takes the old samples and frees them
+            const Uint8 volume = chunk->volume;
+            std::swap(*chunk, *decoded.chunk);
+            chunk->volume = volume;
+            Mix_FreeChunk(decoded.chunk);
+
+            sounds.Replace(decoded.id, chunk, ChunkBytes(chunk.get()));
+            break;
+        }
+        case DecodedAsset::Type::Music: {
+            // Mix_Music is opaque and may be streaming; only later loads get the new one
+            if (decoded.music) {
+                music.Replace(decoded.id, decoded.music, decoded.bytes);
+            }
+            break;
+        }
+    }
+}
+
+size_t AssetManager::ManifestLoad::GetLoadedCount() const {
+    size_t loaded = 0;
+    auto count = [&loaded](const auto& futures) {
+        for (const auto& future : futures) {
+            if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ++loaded;
+        }
+    };
+    count(textures);
+    count(sounds);
+    count(music);
+    return loaded;
+}
+
+AssetManager::ManifestLoad AssetManager::PreloadManifest(const AssetManifest& manifest) {
+    ManifestLoad load;
+    for (const auto& path : manifest.GetTextures()) {
+        load.textures.push_back(LoadTextureAsync(path));
+    }
+    for (const auto& path : manifest.GetSounds()) {
+        load.sounds.push_back(LoadSoundAsync(path));
+    }
+    for (const auto& path : manifest.GetMusic()) {
+        load.music.push_back(LoadMusicAsync(path));
+    }
+    return load;
+}
+
+void AssetManager::LoadManifest(const AssetManifest& manifest) {
+    for (const auto& path : manifest.GetTextures()) {
+        if (!textures.Contains(GetAssetId(path))) LoadTexture(path);
+    }
+    for (const auto& path : manifest.GetSounds()) {
+        if (!sounds.Contains(GetAssetId(path))) LoadSound(path);
+    }
+    for (const auto& path : manifest.GetMusic()) {
+        if (!music.Contains(GetAssetId(path))) LoadMusic(path);
+    }
+}
+
+size_t AssetManager::ReleaseUnused(const AssetManifest& keep) {
+    std::vector<AssetId> ids;
+    ids.reserve(keep.Size());
+    for (const auto* paths : {&keep.GetTextures(), &keep.GetSounds(), &keep.GetMusic()}) {
+        for (const auto& path : *paths) {
+            ids.push_back(GetAssetId(path));
+        }
+    }
+
+    std::vector<bool> kept(assetPaths.Size(), false);
+    for (AssetId id : ids) {
+        kept[ToIndex(id)] = true;
+    }
+
+    auto unused = [&kept](AssetId id) { return !kept[ToIndex(id)]; };
+    return textures.EraseUnreferenced(unused) + sounds.EraseUnreferenced(unused) +
+           music.EraseUnreferenced(unused);
+}
+
+void AssetManager::TrimCaches() {
+    if (textures.IsOverBudget()) textures.Trim();
+    if (sounds.IsOverBudget()) sounds.Trim();
+    if (music.IsOverBudget()) music.Trim();
+    if (spriteSheets.IsOverBudget()) spriteSheets.Trim();
+}
+
+namespace {
+    struct CacheGauges {
+        explicit CacheGauges(const std::string& prefix)
+            : count(Metrics::Instance().GetGauge(prefix + ".count")),
+              bytes(Metrics::Instance().GetGauge(prefix + ".bytes")),
+              hitRate(Metrics::Instance().GetGauge(prefix + ".hit_rate")) {}
+
+        template<typename Stats>
+        void Set(const Stats& stats) const {
+            count.Set(static_cast<double>(stats.assetCount));
+            bytes.Set(static_cast<double>(stats.bytesResident));
+            hitRate.Set(stats.GetHitRate());
+        }
+
+        Metrics::Gauge& count;
+        Metrics::Gauge& bytes;
+        Metrics::Gauge& hitRate;
+    };
+}
+
+void AssetManager::PublishMetrics() const {
+    static const CacheGauges textureGauges("assets.textures");
+    static const CacheGauges soundGauges("assets.sounds");
+    static const CacheGauges musicGauges("assets.music");
+    static const CacheGauges sheetGauges("assets.sheets");
+    static Metrics::Gauge& pendingLoads = Metrics::Instance().GetGauge("assets.pending_loads");
+
+    textureGauges.Set(textures.GetStats());
+    soundGauges.Set(sounds.GetStats());
+    musicGauges.Set(music.GetStats());
+    sheetGauges.Set(spriteSheets.GetStats());
+    pendingLoads.Set(static_cast<double>(GetPendingLoadCount()));
 }
 
 void AssetManager::ClearAssets() {
-    textures.clear();
-    sounds.clear();
-    music.clear();
+    textures.Clear();
+    sounds.Clear();
+    music.Clear();
+    spriteSheets.Clear();
 }
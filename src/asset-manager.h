@@ -4,23 +4,238 @@
 #include <SDL_mixer.h>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "asset-cache.h"
+#include "asset-id.h"
+#include "asset-manifest.h"
+#include "asset-pack.h"
+#include "filewatcher.h"
+#include "spritesheet.h"
+#include "texture-disk-cache.h"
+#include "threadpool.h"
 
 class AssetManager {
 public:
+    // Result of an asynchronous load. Holds nullptr if loading failed.
+    // Async results are delivered by ProcessPendingUploads() on the main
+    // thread, so never block on get() from the main thread; poll with
+    // wait_for(0) or pass a callback instead.
+    template<typename T>
+    using AssetFuture = std::shared_future<std::shared_ptr<T>>;
+
+    template<typename T>
+    using AssetCallback = std::function<void(const std::shared_ptr<T>&)>;
+
+    // Loads started by PreloadManifest(). Holding it keeps the loaded assets
+    // referenced, so cache budgets cannot evict them before they are used.
+    struct ManifestLoad {
+        std::vector<AssetFuture<SDL_Texture>> textures;
+        std::vector<AssetFuture<Mix_Chunk>> sounds;
+        std::vector<AssetFuture<Mix_Music>> music;
+
+        [[nodiscard]] size_t GetTotalCount() const { return textures.size() + sounds.size() + music.size(); }
+        [[nodiscard]] size_t GetLoadedCount() const;
+        [[nodiscard]] bool IsDone() const { return GetLoadedCount() == GetTotalCount(); }
+    };
+
     static AssetManager& Instance();
-    
-    std::shared_ptr<SDL_Texture> LoadTexture(const std::string& path);
-    std::shared_ptr<Mix_Chunk> LoadSound(const std::string& path);
-    std::shared_ptr<Mix_Music> LoadMusic(const std::string& path);
-    
+
+    // Interned id of an asset path. Ids never change, so code that loads the
+    // same asset repeatedly should look the id up once and load by id, which
+    // is a vector index instead of a string hash. Main thread only.
+    AssetId GetAssetId(std::string_view path) { return assetPaths.Intern(path); }
+    // Id of a path that was already interned, or AssetId::Invalid. Use for
+    // queries that should not register new paths. Main thread only.
+    AssetId FindAssetId(std::string_view path) const { return assetPaths.Find(path); }
+    const std::string& GetAssetPath(AssetId id) const { return assetPaths.GetPath(id); }
+
+    std::shared_ptr<SDL_Texture> LoadTexture(AssetId id);
+    std::shared_ptr<Mix_Chunk> LoadSound(AssetId id);
+    std::shared_ptr<Mix_Music> LoadMusic(AssetId id);
+    std::shared_ptr<SDL_Texture> LoadTexture(std::string_view path) { return LoadTexture(GetAssetId(path)); }
+    std::shared_ptr<Mix_Chunk> LoadSound(std::string_view path) { return LoadSound(GetAssetId(path)); }
+    std::shared_ptr<Mix_Music> LoadMusic(std::string_view path) { return LoadMusic(GetAssetId(path)); }
+
+    // Sprite sheet JSON or its compiled binary form (see gfsheet). Every
+    // caller gets the same sheet, so clips are shared rather than copied.
+    std::shared_ptr<SpriteSheet> LoadSpriteSheet(AssetId id);
+    std::shared_ptr<SpriteSheet> LoadSpriteSheet(std::string_view path) { return LoadSpriteSheet(GetAssetId(path)); }
+
+    // Decode on a worker thread. Callbacks run on the main thread from
+    // ProcessPendingUploads(), or immediately if the asset is already loaded.
+    AssetFuture<SDL_Texture> LoadTextureAsync(std::string_view path,
+                                              AssetCallback<SDL_Texture> callback = nullptr);
+    AssetFuture<Mix_Chunk> LoadSoundAsync(std::string_view path,
+                                          AssetCallback<Mix_Chunk> callback = nullptr);
+    AssetFuture<Mix_Music> LoadMusicAsync(std::string_view path,
+                                          AssetCallback<Mix_Music> callback = nullptr);
+
+    // Finish decoded loads on the main thread: create textures and resolve
+    // futures until budgetMs has elapsed. At least one load is finished per
+    // call so progress is guaranteed. Called by Game every frame.
+    void ProcessPendingUploads(float budgetMs);
+
+    // Number of async loads that have not been delivered yet
+    size_t GetPendingLoadCount() const;
+
+    // Start loading every asset of a manifest on worker threads
+    ManifestLoad PreloadManifest(const AssetManifest& manifest);
+
+    // Load whatever a manifest lists that is not cached yet, blocking
+    void LoadManifest(const AssetManifest& manifest);
+
+    // Free cached assets that the manifest does not list and nothing outside
+    // the cache references. Returns the number of assets released.
+    size_t ReleaseUnused(const AssetManifest& keep);
+
+    // Memory budgets per asset type in bytes (0 = unlimited). Over budget,
+    // the least recently used assets that nothing else references are freed.
+    void SetTextureBudget(size_t bytes) { textures.SetBudget(bytes); }
+    void SetSoundBudget(size_t bytes) { sounds.SetBudget(bytes); }
+    void SetMusicBudget(size_t bytes) { music.SetBudget(bytes); }
+    void SetSpriteSheetBudget(size_t bytes) { spriteSheets.SetBudget(bytes); }
+
+    // Evict unreferenced assets from caches that are over budget.
+    // Called from ProcessPendingUploads() so released assets are freed promptly.
+    void TrimCaches();
+
+    // Hit rate, resident bytes and eviction counts per asset type
+    AssetCache<SDL_Texture>::Stats GetTextureStats() const { return textures.GetStats(); }
+    AssetCache<Mix_Chunk>::Stats GetSoundStats() const { return sounds.GetStats(); }
+    AssetCache<Mix_Music>::Stats GetMusicStats() const { return music.GetStats(); }
+    AssetCache<SpriteSheet>::Stats GetSpriteSheetStats() const { return spriteSheets.GetStats(); }
+
+    // Copy cache stats and the pending load count into the assets.* gauges
+    // of the Metrics registry. Called by Game every frame.
+    void PublishMetrics() const;
+
+    // Serve loads from a pack file. Paths under mountPoint (e.g. "assets")
+    // are looked up in the pack with the mount point stripped; packs mounted
+    // later take precedence. Paths not found in any pack load from disk.
+    bool MountPack(const std::string& path, const std::string& mountPoint = "");
+    void UnmountPacks();
+
+    // Keep decoded RGBA pixels of loaded textures in this directory so later
+    // runs skip image decoding. Empty disables the cache. Set before loading.
+    bool SetTextureCacheDirectory(const std::string& path) { return textureDiskCache.SetDirectory(path); }
+    const std::string& GetTextureCacheDirectory() const { return textureDiskCache.GetDirectory(); }
+
+    // Watch the files of loaded assets and reload them when they change.
+    // Changes are decoded on workers and applied by ProcessPendingUploads():
+    // textures keeping their size and sounds are updated in place, so
+    // existing holders see the new data; music and resized textures replace
+    // the cache entry and only later loads get the new version. Assets
+    // served from packs are not watched.
+    void SetHotReloadEnabled(bool enabled);
+    bool IsHotReloadEnabled() const { return fileWatcher != nullptr; }
+
     void ClearAssets();
 
 private:
     AssetManager() = default;
-    ~AssetManager() = default;
-    
-    std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> textures;
-    std::unordered_map<std::string, std::shared_ptr<Mix_Chunk>> sounds;
-    std::unordered_map<std::string, std::shared_ptr<Mix_Music>> music;
+    ~AssetManager();
+
+    // Main-thread bookkeeping for one in-flight async load
+    template<typename T>
+    struct PendingLoad {
+        std::promise<std::shared_ptr<T>> promise;
+        AssetFuture<T> future;
+        std::vector<AssetCallback<T>> callbacks;
+    };
+
+    // Output of a worker, waiting for the main thread
+    struct DecodedAsset {
+        enum class Type { Texture, Sound, Music };
+        Type type;
+        AssetId id;
+        std::string path;   ///< Copy of the interned path for the worker
+        SDL_Surface* surface = nullptr;
+        TextureDiskCache::Image image;  ///< Used instead of surface on a disk cache hit
+        Mix_Chunk* chunk = nullptr;
+        std::shared_ptr<Mix_Music> music;
+        size_t bytes = 0;   ///< Music size estimate
+        std::string error;  ///< SDL error message if decoding failed
+        bool reload = false;  ///< Replaces a cached asset instead of finishing a load
+    };
+
+    // Readable asset data plus whatever must stay alive while it is read
+    struct AssetSource {
+        SDL_RWops* rw = nullptr;
+        std::shared_ptr<void> keepAlive;
+    };
+
+    struct MountedPack {
+        std::shared_ptr<AssetPack> pack;
+        std::string prefix;
+        std::uint64_t stamp;  ///< Identifies the pack file version
+    };
+
+    template<typename T>
+    AssetFuture<T> QueueLoad(AssetId id, DecodedAsset::Type type,
+                             AssetCache<T>& cache,
+                             std::unordered_map<AssetId, PendingLoad<T>>& pending,
+                             AssetCallback<T> callback);
+
+    template<typename T>
+    void Deliver(AssetId id, std::shared_ptr<T> asset, size_t bytes,
+                 AssetCache<T>& cache,
+                 std::unordered_map<AssetId, PendingLoad<T>>& pending);
+
+    // Find the pack entry that serves path; caller must hold packMutex
+    const MountedPack* FindInPacks(const std::string& path, const AssetPack::Entry*& entry) const;
+
+    // Open an asset from the mounted packs or the filesystem (thread-safe)
+    AssetSource OpenAsset(const std::string& path) const;
+
+    // Hash of the source's modification time and size, for the texture disk cache
+    bool GetSourceStamp(const std::string& path, std::uint64_t& stamp) const;
+
+    // Read a texture from the disk cache (into image) or decode it (into surface)
+    bool DecodeTexture(const std::string& path, TextureDiskCache::Image& image,
+                       SDL_Surface*& surface, std::string* error = nullptr) const;
+    SDL_Surface* ReadSurface(const std::string& path, std::string* error = nullptr) const;
+    Mix_Chunk* ReadChunk(const std::string& path, std::string* error = nullptr) const;
+    std::shared_ptr<Mix_Music> ReadMusic(const std::string& path, size_t& bytes,
+                                         std::string* error = nullptr) const;
+
+    // Runs on a worker thread: only file IO and decoding, no renderer access
+    void Decode(DecodedAsset& decoded) const;
+    void FinishLoad(const DecodedAsset& decoded);
+
+    void QueueDecode(AssetId id, DecodedAsset::Type type, bool reload);
+
+    // Hot reload: watch a disk-served asset, queue decodes for changed files
+    // and swap the results into the caches
+    void WatchForReload(AssetId id);
+    void QueueReloads();
+    void ApplyReload(const DecodedAsset& decoded);
+    std::shared_ptr<SDL_Texture> CreateTexture(AssetId id, SDL_Surface* surface);
+    std::shared_ptr<SDL_Texture> CreateTexture(AssetId id, const TextureDiskCache::Image& image);
+    ThreadPool& GetThreadPool();
+
+    AssetPathTable assetPaths;
+    AssetCache<SDL_Texture> textures;
+    AssetCache<Mix_Chunk> sounds;
+    AssetCache<Mix_Music> music;
+    AssetCache<SpriteSheet> spriteSheets;
+
+    // Async loading state. The pending maps are only touched on the main thread.
+    std::unordered_map<AssetId, PendingLoad<SDL_Texture>> pendingTextures;
+    std::unordered_map<AssetId, PendingLoad<Mix_Chunk>> pendingSounds;
+    std::unordered_map<AssetId, PendingLoad<Mix_Music>> pendingMusic;
+    std::deque<DecodedAsset> decodedAssets;     ///< Filled by workers, guarded by decodedMutex
+    std::mutex decodedMutex;
+    std::vector<MountedPack> packs;             ///< Read by workers, guarded by packMutex
+    mutable std::shared_mutex packMutex;
+    TextureDiskCache textureDiskCache;
+    std::vector<std::string> changedFiles;      ///< Reported by the file watcher, guarded by decodedMutex
+    std::unique_ptr<FileWatcher> fileWatcher;
+    std::unique_ptr<ThreadPool> threadPool;     ///< Started on first async load; declared last so it joins first
 };
@@ -0,0 +1,36 @@
+/**
+ * @file asset-manifest.h
+ * @brief List of the assets a scene needs
+ *
+ * A scene fills its manifest (usually in its constructor) so Game can load
+ * the assets in the background before switching to it, and release assets
+ * the scene does not use when it becomes active.
+ */
+#pragma once
+#include <string>
+#include <vector>
+
+class AssetManifest {
+public:
+    void AddTexture(std::string path) { textures.push_back(std::move(path)); }
+    void AddSound(std::string path) { sounds.push_back(std::move(path)); }
+    void AddMusic(std::string path) { music.push_back(std::move(path)); }
+
+    [[nodiscard]] const std::vector<std::string>& GetTextures() const { return textures; }
+    [[nodiscard]] const std::vector<std::string>& GetSounds() const { return sounds; }
+    [[nodiscard]] const std::vector<std::string>& GetMusic() const { return music; }
+
+    [[nodiscard]] size_t Size() const { return textures.size() + sounds.size() + music.size(); }
+    [[nodiscard]] bool IsEmpty() const { return Size() == 0; }
+
+    void Clear() {
+        textures.clear();
+        sounds.clear();
+        music.clear();
+    }
+
+private:
+    std::vector<std::string> textures;
+    std::vector<std::string> sounds;
+    std::vector<std::string> music;
+};
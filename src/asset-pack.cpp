@@ -0,0 +1,276 @@
+#include "asset-pack.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+#ifdef GAMEFRAMEWORK_HAS_LZ4
+#include <lz4.h>
+#endif
+
+namespace {
+    std::uint32_t ReadU32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) |
+               static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 |
+               static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    std::uint64_t ReadU64(const std::uint8_t* p) {
+        return static_cast<std::uint64_t>(ReadU32(p)) |
+               static_cast<std::uint64_t>(ReadU32(p + 4)) << 32;
+    }
+
+    void WriteU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    void WriteU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        WriteU32(out, static_cast<std::uint32_t>(value));
+        WriteU32(out, static_cast<std::uint32_t>(value >> 32));
+    }
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+std::unique_ptr<AssetPack> AssetPack::Open(const std::string& path) {
+    std::unique_ptr<AssetPack> pack(new AssetPack());
+    pack->path = path;
+
+    if (!pack->file.Open(path)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map asset pack '%s'", path.c_str());
+        return nullptr;
+    }
+
+    if (!pack->ReadIndex()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Malformed asset pack '%s'", path.c_str());
+        return nullptr;
+    }
+
+    return pack;
+}
+
+bool AssetPack::ReadIndex() {
+    const std::uint8_t* base = file.GetData();
+    const size_t fileSize = file.GetSize();
+
+    if (fileSize < kHeaderSize || std::memcmp(base, kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    if (ReadU32(base + 4) != kVersion) {
+        return false;
+    }
+
+    const size_t count = ReadU32(base + 8);
+    const size_t stringTableSize = ReadU32(base + 12);
+    const size_t stringTableOffset = kHeaderSize + count * kIndexEntrySize;
+    if (stringTableOffset + stringTableSize > fileSize) {
+        return false;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(base + stringTableOffset);
+    entries.reserve(count);
+    lookup.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const std::uint8_t* record = base + kHeaderSize + i * kIndexEntrySize;
+        const std::uint64_t offset = ReadU64(record);
+        const std::uint64_t storedSize = ReadU64(record + 8);
+        const std::uint64_t size = ReadU64(record + 16);
+        const std::uint32_t nameOffset = ReadU32(record + 24);
+        const std::uint32_t nameLength = ReadU32(record + 28);
+        const std::uint32_t compression = ReadU32(record + 32);
+
+        if (offset > fileSize || storedSize > fileSize - offset ||
+            static_cast<size_t>(nameOffset) + nameLength > stringTableSize ||
+            compression > static_cast<std::uint32_t>(Compression::LZ4)) {
+            return false;
+        }
+        // Blobs are read through SDL_RWops, which take int sizes
+        if (size > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) ||
+            (compression == static_cast<std::uint32_t>(Compression::None) && size != storedSize)) {
+            return false;
+        }
+
+        Entry entry{
+            std::string_view(strings + nameOffset, nameLength),
+            base + offset,
+            static_cast<size_t>(storedSize),
+            static_cast<size_t>(size),
+            static_cast<Compression>(compression)
+        };
+        lookup.emplace(entry.name, entries.size());
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+const AssetPack::Entry* AssetPack::Find(std::string_view name) const {
+    auto it = lookup.find(name);
+    return it != lookup.end() ? &entries[it->second] : nullptr;
+}
+
+bool AssetPack::Extract(const Entry& entry, std::vector<std::uint8_t>& out) const {
+    if (entry.compression == Compression::None) {
+        out.assign(entry.data, entry.data + entry.storedSize);
+        return true;
+    }
+
+#ifdef GAMEFRAMEWORK_HAS_LZ4
+    if (entry.size > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        entry.storedSize > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    out.resize(entry.size);
+    int written = LZ4_decompress_safe(reinterpret_cast<const char*>(entry.data),
+                                      reinterpret_cast<char*>(out.data()),
+                                      static_cast<int>(entry.storedSize),
+                                      static_cast<int>(entry.size));
+    if (written < 0 || static_cast<size_t>(written) != entry.size) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Corrupt LZ4 entry '%.*s' in '%s'",
+                     static_cast<int>(entry.name.size()), entry.name.data(), path.c_str());
+        out.clear();
+        return false;
+    }
+    return true;
+#else
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Entry '%.*s' in '%s' is LZ4-compressed but LZ4 support is not built in",
+                 static_cast<int>(entry.name.size()), entry.name.data(), path.c_str());
+    return false;
+#endif
+}
+
+bool AssetPack::IsCompressionSupported() {
+#ifdef GAMEFRAMEWORK_HAS_LZ4
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AssetPackWriter::AddEntry(const std::string& name, std::vector<std::uint8_t> data) {
+    pending[name] = std::move(data);
+}
+
+bool AssetPackWriter::AddFile(const std::string& name, const std::string& filePath) {
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (in.bad()) {
+        return false;
+    }
+
+    AddEntry(name, std::move(data));
+    return true;
+}
+
+bool AssetPackWriter::Write(const std::string& filePath) const {
+    // Sorted names make packs reproducible regardless of insertion order
+    std::vector<const std::string*> names;
+    names.reserve(pending.size());
+    for (const auto& [name, data] : pending) {
+        names.push_back(&name);
+    }
+    std::sort(names.begin(), names.end(),
+        [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    using Compression = AssetPack::Compression;
+    struct Blob {
+        const std::vector<std::uint8_t>* data;
+        std::vector<std::uint8_t> compressed;
+        Compression compression = Compression::None;
+    };
+
+    std::vector<Blob> blobs(names.size());
+    std::string stringTable;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const auto& data = pending.at(*names[i]);
+        blobs[i].data = &data;
+        stringTable += *names[i];
+
+#ifdef GAMEFRAMEWORK_HAS_LZ4
+        if (compress && !data.empty() && data.size() <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+            auto& compressed = blobs[i].compressed;
+            compressed.resize(LZ4_compressBound(static_cast<int>(data.size())));
+            int written = LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
+                                               reinterpret_cast<char*>(compressed.data()),
+                                               static_cast<int>(data.size()),
+                                               static_cast<int>(compressed.size()));
+            // Keep the raw bytes when compression does not pay off
+            if (written > 0 && static_cast<size_t>(written) < data.size()) {
+                compressed.resize(written);
+                blobs[i].compression = Compression::LZ4;
+            } else {
+                compressed.clear();
+            }
+        }
+#endif
+    }
+
+    if (stringTable.size() > std::numeric_limits<std::uint32_t>::max() ||
+        names.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> header;
+    header.insert(header.end(), std::begin(AssetPack::kMagic), std::end(AssetPack::kMagic));
+    WriteU32(header, AssetPack::kVersion);
+    WriteU32(header, static_cast<std::uint32_t>(names.size()));
+    WriteU32(header, static_cast<std::uint32_t>(stringTable.size()));
+
+    size_t offset = AlignUp(AssetPack::kHeaderSize + names.size() * AssetPack::kIndexEntrySize +
+                            stringTable.size(), AssetPack::kBlobAlignment);
+    std::vector<size_t> offsets(names.size());
+    std::uint32_t nameOffset = 0;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        const Blob& blob = blobs[i];
+        const size_t storedSize = blob.compression == Compression::None ? blob.data->size() : blob.compressed.size();
+
+        offsets[i] = offset;
+        WriteU64(header, offset);
+        WriteU64(header, storedSize);
+        WriteU64(header, blob.data->size());
+        WriteU32(header, nameOffset);
+        WriteU32(header, static_cast<std::uint32_t>(names[i]->size()));
+        WriteU32(header, static_cast<std::uint32_t>(blob.compression));
+        WriteU32(header, 0);
+
+        nameOffset += static_cast<std::uint32_t>(names[i]->size());
+        offset = AlignUp(offset + storedSize, AssetPack::kBlobAlignment);
+    }
+    header.insert(header.end(), stringTable.begin(), stringTable.end());
+
+    std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    static const char padding[AssetPack::kBlobAlignment] = {};
+    size_t position = header.size();
+    for (size_t i = 0; i < names.size(); ++i) {
+        out.write(padding, static_cast<std::streamsize>(offsets[i] - position));
+
+        const Blob& blob = blobs[i];
+        const auto& bytes = blob.compression == Compression::None ? *blob.data : blob.compressed;
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        position = offsets[i] + bytes.size();
+    }
+
+    return static_cast<bool>(out);
+}
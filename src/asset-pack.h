@@ -0,0 +1,122 @@
+/**
+ * @file asset-pack.h
+ * @brief Packed asset archives read through a memory mapping
+ *
+ * A pack bundles many asset files into one archive so loading them costs a
+ * single open and a handful of page faults instead of one open/read per file.
+ *
+ * Layout (all integers little-endian):
+ * - Header: magic "GFPK", version, entry count, string table size (16 bytes)
+ * - Index: one 40-byte record per entry, sorted by name
+ * - String table: entry names, not null-terminated
+ * - Blobs: entry data, each starting on a 16-byte boundary
+ *
+ * Entries may be LZ4-compressed when the library is built with LZ4 support.
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "mappedfile.h"
+
+class AssetPack {
+public:
+    enum class Compression : std::uint32_t {
+        None = 0,
+        LZ4 = 1
+    };
+
+    // One archived file. Pointers stay valid while the pack is alive.
+    struct Entry {
+        std::string_view name;
+        const std::uint8_t* data;   ///< Stored (possibly compressed) bytes
+        size_t storedSize;
+        size_t size;                ///< Size after decompression
+        Compression compression;
+    };
+
+    static constexpr char kMagic[4] = {'G', 'F', 'P', 'K'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 16;
+    static constexpr size_t kIndexEntrySize = 40;
+    static constexpr size_t kBlobAlignment = 16;
+
+    /**
+     * @brief Map a pack file and read its index
+     * @param path Pack file to open
+     * @return The pack, or nullptr if it cannot be opened or is malformed
+     */
+    static std::unique_ptr<AssetPack> Open(const std::string& path);
+
+    /**
+     * @brief Look up an entry by name
+     * @param name Entry name as stored in the pack
+     * @return Entry, or nullptr if the pack has no such entry
+     */
+    [[nodiscard]] const Entry* Find(std::string_view name) const;
+
+    /**
+     * @brief Copy an entry into a buffer, decompressing if needed
+     * @param entry Entry from this pack
+     * @param out Receives the entry's contents
+     * @return False if the entry cannot be decompressed
+     */
+    bool Extract(const Entry& entry, std::vector<std::uint8_t>& out) const;
+
+    [[nodiscard]] const std::vector<Entry>& GetEntries() const { return entries; }
+    [[nodiscard]] const std::string& GetPath() const { return path; }
+
+    /**
+     * @brief Check whether this build can read and write LZ4 entries
+     */
+    static bool IsCompressionSupported();
+
+private:
+    AssetPack() = default;
+
+    bool ReadIndex();
+
+    std::string path;
+    MappedFile file;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string_view, size_t> lookup;  ///< Names point into the mapping
+};
+
+/**
+ * @class AssetPackWriter
+ * @brief Builds pack files; used by the gfpack tool
+ */
+class AssetPackWriter {
+public:
+    /**
+     * @brief Compress entries with LZ4 where it makes them smaller
+     * Ignored if the build has no LZ4 support.
+     */
+    void SetCompression(bool enabled) { compress = enabled; }
+
+    /**
+     * @brief Add an entry from memory, replacing any entry with the same name
+     */
+    void AddEntry(const std::string& name, std::vector<std::uint8_t> data);
+
+    /**
+     * @brief Add an entry read from a file
+     * @return False if the file cannot be read
+     */
+    bool AddFile(const std::string& name, const std::string& filePath);
+
+    /**
+     * @brief Write all entries to a pack file
+     * @return False if the file cannot be written
+     */
+    bool Write(const std::string& filePath) const;
+
+    [[nodiscard]] size_t GetEntryCount() const { return pending.size(); }
+
+private:
+    std::unordered_map<std::string, std::vector<std::uint8_t>> pending;
+    bool compress = false;
+};
@@ -4,7 +4,9 @@
 
 #include "audiomanager.h"
 #include "asset-manager.h"
+#include "debug/metrics.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 void AudioManager::ChannelFinishedCallback(int channel) {
@@ -31,7 +33,11 @@ void AudioManager::Initialize() {
         throw std::runtime_error("SDL_mixer initialization failed: " + std::string(Mix_GetError()));
     }
 
-    Mix_AllocateChannels(16);
+    // Sized once from the mixer's channel count and never resized, because
+    // the finished callback writes channelSounds from the audio thread
+    const int channels = Mix_AllocateChannels(16);
+    channelSounds.assign(static_cast<size_t>(channels), AssetId::Invalid);
+    channelChunks.resize(static_cast<size_t>(channels));
     Mix_ChannelFinished(ChannelFinishedCallback);
     initialized = true;
 }
@@ -40,7 +46,8 @@ void AudioManager::Cleanup() {
     if (!initialized) return;
 
     StopAll();
-    channelMap.clear();
+    channelSounds.clear();
+    channelChunks.clear();
     currentMusic = nullptr;
     currentMusicPath.clear();
 
@@ -49,10 +56,14 @@ void AudioManager::Cleanup() {
 }
 
 int AudioManager::PlaySound(const std::string& path, const PlayConfig& config) {
+    return PlaySound(AssetManager::Instance().GetAssetId(path), config);
+}
+
+int AudioManager::PlaySound(AssetId soundId, const PlayConfig& config) {
     if (!soundEnabled || !initialized) return -1;
 
     try {
-        auto sound = AssetManager::Instance().LoadSound(path);
+        auto sound = AssetManager::Instance().LoadSound(soundId);
         if (!sound) return -1;
 
         // Apply volume with master volume scaling
@@ -72,8 +83,16 @@ int AudioManager::PlaySound(const std::string& path, const PlayConfig& config) {
             return -1;
         }
 
-        // Track the sound path for this channel
-        channelMap[channel] = path;
+        // Track the sound for this channel; channels allocated behind our
+        // back with Mix_AllocateChannels() are played but not tracked
+        if (static_cast<size_t>(channel) < channelSounds.size()) {
+            channelSounds[channel] = soundId;
+            // Keeps the asset cache from freeing the chunk while it plays
+            channelChunks[channel] = std::move(sound);
+        }
+
+        static Metrics::Counter& soundsPlayed = Metrics::Instance().GetCounter("audio.sounds_played");
+        soundsPlayed.Add();
         return channel;
 
     } catch (const std::exception& e) {
@@ -82,11 +101,15 @@ int AudioManager::PlaySound(const std::string& path, const PlayConfig& config) {
     }
 }
 
-int AudioManager::PlayLoopedSound(const std::string& path, int volume) {
+int AudioManager::PlayLoopedSound(AssetId sound, int volume) {
     PlayConfig config;
     config.loops = -1;  // Infinite loop
     config.volume = volume;
-    return PlaySound(path, config);
+    return PlaySound(sound, config);
+}
+
+int AudioManager::PlayLoopedSound(const std::string& path, int volume) {
+    return PlayLoopedSound(AssetManager::Instance().GetAssetId(path), volume);
 }
 
 void AudioManager::StopSound(int channel, int fadeOutMs) {
@@ -99,14 +122,21 @@ void AudioManager::StopSound(int channel, int fadeOutMs) {
     }
 }
 
-void AudioManager::StopSound(const std::string& path, int fadeOutMs) {
-    for (const auto& [channel, soundPath] : channelMap) {
-        if (soundPath == path) {
-            StopSound(channel, fadeOutMs);
+void AudioManager::StopSound(AssetId sound, int fadeOutMs) {
+    if (sound == AssetId::Invalid) return;
+
+    for (size_t channel = 0; channel < channelSounds.size(); ++channel) {
+        if (channelSounds[channel] == sound) {
+            StopSound(static_cast<int>(channel), fadeOutMs);
         }
     }
 }
 
+void AudioManager::StopSound(const std::string& path, int fadeOutMs) {
+    // A path that was never interned was never played
+    StopSound(AssetManager::Instance().FindAssetId(path), fadeOutMs);
+}
+
 void AudioManager::SetSoundVolume(int channel, int volume) {
     if (!initialized) return;
     Mix_Volume(channel, static_cast<int>(volume * (masterVolume / 128.0f)));
@@ -188,15 +218,21 @@ bool AudioManager::IsMusicPaused() const {
     return Mix_PausedMusic() == 1;
 }
 
-int AudioManager::FindChannel(const std::string& path) const {
-    for (const auto& [channel, soundPath] : channelMap) {
-        if (soundPath == path) {
-            return channel;
+int AudioManager::FindChannel(AssetId sound) const {
+    if (sound == AssetId::Invalid) return -1;
+
+    for (size_t channel = 0; channel < channelSounds.size(); ++channel) {
+        if (channelSounds[channel] == sound) {
+            return static_cast<int>(channel);
         }
     }
     return -1;
 }
 
+int AudioManager::FindChannel(const std::string& path) const {
+    return FindChannel(AssetManager::Instance().FindAssetId(path));
+}
+
 void AudioManager::StopAll(int fadeOutMs) {
     if (!initialized) return;
 
@@ -210,7 +246,7 @@ void AudioManager::StopAll(int fadeOutMs) {
     // Stop music
     StopMusic(fadeOutMs);
 
-    channelMap.clear();
+    std::fill(channelSounds.begin(), channelSounds.end(), AssetId::Invalid);
 }
 
 void AudioManager::PauseAll() {
@@ -227,9 +263,9 @@ void AudioManager::SetMasterVolume(int volume) {
     masterVolume = std::clamp(volume, 0, 128);
 
     // Update all playing sounds
-    for (const auto& [channel, _] : channelMap) {
-        if (Mix_Playing(channel)) {
-            Mix_Volume(channel, Mix_Volume(channel, -1) * masterVolume / 128);
+    for (size_t channel = 0; channel < channelSounds.size(); ++channel) {
+        if (channelSounds[channel] != AssetId::Invalid && Mix_Playing(static_cast<int>(channel))) {
+            Mix_Volume(static_cast<int>(channel), Mix_Volume(static_cast<int>(channel), -1) * masterVolume / 128);
         }
     }
 
@@ -258,6 +294,16 @@ int AudioManager::GetMusicVolume() const {
     return Mix_VolumeMusic(-1);
 }
 
+void AudioManager::ReleaseFinishedChannels() {
+    for (size_t channel = 0; channel < channelChunks.size(); ++channel) {
+        if (channelChunks[channel] && !Mix_Playing(static_cast<int>(channel))) {
+            channelChunks[channel].reset();
+        }
+    }
+}
+
 void AudioManager::OnChannelFinished(int channel) {
-    channelMap.erase(channel);
+    if (channel >= 0 && static_cast<size_t>(channel) < channelSounds.size()) {
+        channelSounds[channel] = AssetId::Invalid;
+    }
 }
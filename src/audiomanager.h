@@ -3,8 +3,10 @@
 //
 #pragma once
 #include <SDL_mixer.h>
+#include <memory>
 #include <string>
-#include <map>
+#include <vector>
+#include "asset-id.h"
 
 class AudioManager {
 public:
@@ -23,10 +25,14 @@ public:
     AudioManager(const AudioManager&) = delete;
     AudioManager& operator=(const AudioManager&) = delete;
 
-    // Sound effects control
+    // Sound effects control. Sounds played often (e.g. every shot) should be
+    // played by AssetId from AssetManager::GetAssetId() to skip path lookups.
+    int PlaySound(AssetId sound, const PlayConfig& config);
     int PlaySound(const std::string& path, const PlayConfig& config);
-    int PlayLoopedSound(const std::string& path, int volume = 128); // Returns channel ID
+    int PlayLoopedSound(AssetId sound, int volume = 128); // Returns channel ID
+    int PlayLoopedSound(const std::string& path, int volume = 128);
     void StopSound(int channel, int fadeOutMs = 0);
+    void StopSound(AssetId sound, int fadeOutMs = 0);
     void StopSound(const std::string& path, int fadeOutMs = 0);
     void SetSoundVolume(int channel, int volume); // 0-128
     bool IsSoundPlaying(int channel) const;
@@ -43,6 +49,7 @@ public:
     bool IsMusicPaused() const;
 
     // Find channel by sound
+    int FindChannel(AssetId sound) const;
     int FindChannel(const std::string& path) const;
 
     // Global audio control
@@ -62,6 +69,10 @@ public:
     [[nodiscard]] int GetMusicVolume() const;
     [[nodiscard]] const std::string& GetCurrentMusic() const { return currentMusicPath; }
 
+    // Drop the references playing channels hold to their sounds once they
+    // finish, so the asset cache can free them. Called by Game every frame.
+    void ReleaseFinishedChannels();
+
 private:
     AudioManager();
     ~AudioManager();
@@ -73,8 +84,13 @@ private:
     bool soundEnabled = true;
     int masterVolume = 128;
 
-    // Keep track of what sound is playing on each channel
-    std::map<int, std::string> channelMap;
+    // Keep track of what sound is playing on each channel, indexed by channel.
+    // Sized once in Initialize(); the finished callback writes it from the
+    // audio thread, so it must never be resized while audio is open.
+    std::vector<AssetId> channelSounds;
+    // Chunk playing on each channel. Released on the main thread by
+    // ReleaseFinishedChannels(), never from the finished callback.
+    std::vector<std::shared_ptr<Mix_Chunk>> channelChunks;
     // Track current music
     std::shared_ptr<Mix_Music> currentMusic;
     std::string currentMusicPath;
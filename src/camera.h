@@ -1,22 +1,60 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <memory>
 #include "vector2d.h"
+#include "matrix2d.h"
 #include "gameobject.h"
 #include "game.h"
+#include "rendertarget.h"
 
 /**
  * @brief Camera system for controlling view and viewport
+ *
+ * Any number of cameras can exist; a Scene renders through each of its
+ * cameras in turn, each into its own viewport. Instance() provides a
+ * shared default camera for single-view games.
  */
 class Camera {
 public:
+    /**
+     * @brief Get the shared default camera
+     * @deprecated Scenes render through the cameras added with
+     * Scene::AddCamera(), and this camera is not one of them unless it is
+     * added. It never tracks the camera being rendered; use GetActive() for
+     * that, and own Camera objects in new code.
+     */
     static Camera& Instance() {
         static Camera instance;
         return instance;
     }
 
+    Camera() : viewport{0, 0, 0, 0}, zoom(1.0f), rotation(0.0f), isShaking(false),
+               shakeTime(0.0f), shakeIntensity(0.0f) {}
+
+    /**
+     * @brief Create a camera showing the given viewport
+     * @param viewport Screen area the camera renders to
+     */
+    explicit Camera(const SDL_Rect& viewport) : Camera() {
+        Initialize(viewport);
+    }
+
     Camera(const Camera&) = delete;
     Camera& operator=(const Camera&) = delete;
 
+    /**
+     * @brief Get the camera currently being rendered through
+     * @return Active camera, or nullptr when rendering in screen space
+     */
+    static const Camera* GetActive() { return activeCamera; }
+
+    /**
+     * @brief Set the camera that sprites and other renderables project through
+     * Scene sets this while rendering each of its cameras.
+     * @param camera Camera to activate, or nullptr for screen space
+     */
+    static void SetActive(const Camera* camera) { activeCamera = camera; }
+
     /**
      * @brief Initialize the camera
      * @param viewport Initial viewport size
@@ -26,6 +64,25 @@ public:
         position = Vector2D(viewport.x, viewport.y);
         zoom = 1.0f;
         rotation = 0.0f;
+        viewDirty = true;
+    }
+
+    /**
+     * @brief Set the screen area the camera renders to
+     * @param newViewport Viewport in screen (or render target) coordinates
+     */
+    void SetViewport(const SDL_Rect& newViewport) {
+        viewport = newViewport;
+        viewDirty = true;
+    }
+
+    /**
+     * @brief Render this camera's view into an offscreen target
+     * The viewport is then interpreted in target coordinates.
+     * @param target Render target, or nullptr to render to the screen
+     */
+    void SetRenderTarget(std::shared_ptr<RenderTarget> target) {
+        renderTarget = std::move(target);
     }
 
     /**
@@ -34,6 +91,7 @@ public:
      */
     void SetPosition(const Vector2D& pos) {
         position = pos;
+        viewDirty = true;
     }
 
     /**
@@ -44,6 +102,7 @@ public:
         zoom = newZoom;
         if (zoom < 0.1f) zoom = 0.1f;
         if (zoom > 10.0f) zoom = 10.0f;
+        viewDirty = true;
     }
 
     /**
@@ -52,6 +111,7 @@ public:
      */
     void SetRotation(float degrees) {
         rotation = degrees;
+        viewDirty = true;
     }
 
     /**
@@ -62,9 +122,10 @@ public:
     void FollowTarget(GameObject* target, float smoothing = 0.1f) {
         if (!target) return;
 
-        Vector2D targetPos = target->GetTransform().GetPosition();
+        Vector2D targetPos = target->GetWorldTransform().GetPosition();
         Vector2D delta = targetPos - position;
         position += delta * smoothing;
+        viewDirty = true;
     }
 
     /**
@@ -73,24 +134,7 @@ public:
      * @return Position in screen space
      */
     Vector2D WorldToScreen(const Vector2D& worldPos) const {
-        // Translate relative to camera
-        Vector2D relativePos = worldPos - position;
-        
-        // Apply zoom
-        relativePos *= zoom;
-        
-        // Apply rotation
-        float rad = rotation * M_PI / 180.0f;
-        float cos_r = cos(rad);
-        float sin_r = sin(rad);
-        float x = relativePos.x * cos_r - relativePos.y * sin_r;
-        float y = relativePos.x * sin_r + relativePos.y * cos_r;
-        
-        // Center on screen
-        return Vector2D(
-            viewport.x + viewport.w / 2.0f + x,
-            viewport.y + viewport.h / 2.0f + y
-        );
+        return GetViewMatrix().TransformPoint(worldPos);
     }
 
     /**
@@ -99,33 +143,52 @@ public:
      * @return Position in world space
      */
     Vector2D ScreenToWorld(const Vector2D& screenPos) const {
-        // Center relative to viewport
-        Vector2D centered(
-            screenPos.x - (viewport.x + viewport.w / 2.0f),
-            screenPos.y - (viewport.y + viewport.h / 2.0f)
-        );
-        
-        // Apply inverse rotation
-        float rad = -rotation * M_PI / 180.0f;
-        float cos_r = cos(rad);
-        float sin_r = sin(rad);
-        float x = centered.x * cos_r - centered.y * sin_r;
-        float y = centered.x * sin_r + centered.y * cos_r;
-        
-        // Apply inverse zoom and translate back to world space
-        return Vector2D(x, y) / zoom + position;
+        UpdateView();
+        return inverseViewMatrix.TransformPoint(screenPos);
+    }
+
+    /**
+     * @brief Get the world-to-screen matrix
+     *
+     * Translates relative to the camera, applies zoom and rotation, then
+     * centers on the viewport (including shake). The matrix is cached and
+     * only rebuilt after the camera changes.
+     * @return View matrix
+     */
+    const Matrix2D& GetViewMatrix() const {
+        UpdateView();
+        return viewMatrix;
     }
 
     /**
-     * @brief Get the camera's view matrix for rendering
-     * @return SDL_Rect representing the view
+     * @brief Get the area of the world visible through the camera
+     * Includes the current shake offset, matching what is drawn.
+     * @return Axis-aligned world rectangle enclosing the (possibly rotated) view
      */
     SDL_Rect GetViewRect() const {
+        float extentW = static_cast<float>(viewport.w);
+        float extentH = static_cast<float>(viewport.h);
+        if (rotation != 0.0f) {
+            UpdateView();
+            float cos_r = std::fabs(cosRotation);
+            float sin_r = std::fabs(sinRotation);
+            extentW = viewport.w * cos_r + viewport.h * sin_r;
+            extentH = viewport.w * sin_r + viewport.h * cos_r;
+        }
+
+        // Shaking moves the screen center, so the world point under it moves too
+        Vector2D center = position;
+        if (shakeOffset.x != 0.0f || shakeOffset.y != 0.0f) {
+            UpdateView();
+            center = inverseViewMatrix.TransformPoint(
+                Vector2D(viewport.x + viewport.w / 2.0f, viewport.y + viewport.h / 2.0f));
+        }
+
         return {
-            static_cast<int>(position.x - viewport.w / (2.0f * zoom)),
-            static_cast<int>(position.y - viewport.h / (2.0f * zoom)),
-            static_cast<int>(viewport.w / zoom),
-            static_cast<int>(viewport.h / zoom)
+            static_cast<int>(center.x - extentW / (2.0f * zoom)),
+            static_cast<int>(center.y - extentH / (2.0f * zoom)),
+            static_cast<int>(extentW / zoom),
+            static_cast<int>(extentH / zoom)
         };
     }
 
@@ -165,6 +228,7 @@ public:
                 shakeOffset.x = cos(randomAngle) * shakeIntensity;
                 shakeOffset.y = sin(randomAngle) * shakeIntensity;
             }
+            viewDirty = true;
         }
     }
 
@@ -174,10 +238,37 @@ public:
     float GetRotation() const { return rotation; }
     const SDL_Rect& GetViewport() const { return viewport; }
     const Vector2D& GetShakeOffset() const { return shakeOffset; }
+    const std::shared_ptr<RenderTarget>& GetRenderTarget() const { return renderTarget; }
 
 private:
-    Camera() : zoom(1.0f), rotation(0.0f), isShaking(false), 
-               shakeTime(0.0f), shakeIntensity(0.0f) {}
+    static inline const Camera* activeCamera = nullptr;
+
+    /**
+     * @brief Rebuild the cached view matrices if the camera changed
+     */
+    void UpdateView() const {
+        if (!viewDirty) return;
+
+        float rad = rotation * M_PI / 180.0f;
+        cosRotation = cos(rad);
+        sinRotation = sin(rad);
+
+        // screen = center + shake + zoom * R * (world - position)
+        float a = zoom * cosRotation;
+        float b = zoom * sinRotation;
+        Vector2D center(
+            viewport.x + viewport.w / 2.0f + shakeOffset.x,
+            viewport.y + viewport.h / 2.0f + shakeOffset.y
+        );
+        viewMatrix = Matrix2D(
+            a, b,
+            -b, a,
+            center.x - (a * position.x - b * position.y),
+            center.y - (b * position.x + a * position.y)
+        );
+        inverseViewMatrix = viewMatrix.Inverse();
+        viewDirty = false;
+    }
 
     SDL_Rect viewport;      // Current viewport rectangle
     Vector2D position;      // Camera position in world coordinates
@@ -189,4 +280,13 @@ private:
     float shakeTime;
     float shakeIntensity;
     Vector2D shakeOffset;
+
+    std::shared_ptr<RenderTarget> renderTarget;  // Optional offscreen destination
+
+    // Cached view, rebuilt lazily after any change
+    mutable Matrix2D viewMatrix;
+    mutable Matrix2D inverseViewMatrix;
+    mutable float cosRotation = 1.0f;
+    mutable float sinRotation = 0.0f;
+    mutable bool viewDirty = true;
 };
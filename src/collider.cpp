@@ -1,7 +1,25 @@
 #include "collider.h"
+#include <array>
 #include <cmath>
 #include <algorithm>
 
+namespace {
+    constexpr int kCircleSegments = 32;
+
+    // Unit circle outline used for debug drawing, computed once
+    const std::array<Vector2D, kCircleSegments + 1>& UnitCircle() {
+        static const auto points = [] {
+            std::array<Vector2D, kCircleSegments + 1> result;
+            for (int i = 0; i <= kCircleSegments; ++i) {
+                float angle = i * 2 * M_PI / kCircleSegments;
+                result[i] = Vector2D(std::cos(angle), std::sin(angle));
+            }
+            return result;
+        }();
+        return points;
+    }
+}
+
 Collider::Collider(Type type, float width, float height)
     : type(type)
     , width(width)
@@ -64,18 +82,14 @@ void Collider::RenderDebug(SDL_Renderer* renderer, const Transform& transform) {
         }
         case Type::Circle: {
             // Approximate circle with lines
-            const int segments = 32;
             const float radius = width * transform.scale.x / 2;
-            float angleStep = 2 * M_PI / segments;
-
-            for (int i = 0; i < segments; ++i) {
-                float angle1 = i * angleStep;
-                float angle2 = (i + 1) * angleStep;
+            const auto& circle = UnitCircle();
 
-                int x1 = static_cast<int>(transform.position.x + radius * std::cos(angle1));
-                int y1 = static_cast<int>(transform.position.y + radius * std::sin(angle1));
-                int x2 = static_cast<int>(transform.position.x + radius * std::cos(angle2));
-                int y2 = static_cast<int>(transform.position.y + radius * std::sin(angle2));
+            for (int i = 0; i < kCircleSegments; ++i) {
+                int x1 = static_cast<int>(transform.position.x + radius * circle[i].x);
+                int y1 = static_cast<int>(transform.position.y + radius * circle[i].y);
+                int x2 = static_cast<int>(transform.position.x + radius * circle[i + 1].x);
+                int y2 = static_cast<int>(transform.position.y + radius * circle[i + 1].y);
 
                 SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
             }
@@ -129,25 +143,10 @@ std::vector<Vector2D> Collider::GetTransformedPoints(const Transform& transform)
     std::vector<Vector2D> transformedPoints;
     transformedPoints.reserve(points.size());
 
-    float radians = transform.rotation * M_PI / 180.0f;
-    float cos_r = std::cos(radians);
-    float sin_r = std::sin(radians);
-
+    // Scale, rotate and translate using the transform's cached matrix
+    const Matrix2D& matrix = transform.GetMatrix();
     for (const auto& point : points) {
-        // Scale
-        Vector2D scaled(point.x * transform.scale.x, point.y * transform.scale.y);
-
-        // Rotate
-        Vector2D rotated(
-            scaled.x * cos_r - scaled.y * sin_r,
-            scaled.x * sin_r + scaled.y * cos_r
-        );
-
-        // Translate
-        transformedPoints.emplace_back(
-            rotated.x + transform.position.x,
-            rotated.y + transform.position.y
-        );
+        transformedPoints.push_back(matrix.TransformPoint(point));
     }
 
     return transformedPoints;
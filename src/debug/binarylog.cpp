@@ -0,0 +1,79 @@
+#include "binarylog.h"
+#include <algorithm>
+#include <cstring>
+
+bool BinaryLogReader::Open(const std::string& path) {
+    in.close();
+    in.clear();
+    formats.clear();
+    error = false;
+
+    in.open(path, std::ios::in | std::ios::binary | std::ios::ate);
+    fileSize = in.is_open() ? static_cast<std::uint64_t>(in.tellg()) : 0;
+    in.seekg(0);
+
+    char magic[sizeof(BinaryLog::kMagic)];
+    std::uint16_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || !Read(version) ||
+        std::memcmp(magic, BinaryLog::kMagic, sizeof(magic)) != 0 || version != BinaryLog::kVersion) {
+        in.close();
+        return false;
+    }
+    return true;
+}
+
+bool BinaryLogReader::ReadString(std::string& text) {
+    std::uint32_t length = 0;
+    if (!Read(length)) return false;
+
+    // Lengths come from the file; never allocate more than it holds
+    const auto position = static_cast<std::uint64_t>(in.tellg());
+    if (length > fileSize - std::min(position, fileSize)) return false;
+
+    text.resize(length);
+    return length == 0 || static_cast<bool>(in.read(text.data(), length));
+}
+
+bool BinaryLogReader::Next(Entry& entry) {
+    if (!in.is_open() || error) return false;
+
+    std::uint8_t type = 0;
+    for (;;) {
+        if (!Read(type)) {
+            // Running out of data exactly between records is the normal end
+            error = !in.eof();
+            return false;
+        }
+
+        if (type == static_cast<std::uint8_t>(BinaryLog::RecordType::Format)) {
+            std::uint32_t id = 0;
+            Format format;
+            // The writer defines formats once each, in ID order
+            if (!Read(id) || id != formats.size() + 1 ||
+                !ReadString(format.format) || !ReadString(format.signature)) break;
+            formats.push_back(std::move(format));
+            continue;
+        }
+
+        if (type != static_cast<std::uint8_t>(BinaryLog::RecordType::Message)) break;
+
+        std::uint8_t level = 0;
+        std::uint32_t id = 0;
+        if (!Read(entry.timestamp) || !Read(level) || !Read(id) || !ReadString(payload)) break;
+        entry.level = static_cast<LogLevel>(level);
+
+        if (id == 0) {
+            entry.text = payload;
+            return true;
+        }
+        if (id > formats.size()) break;
+
+        entry.text.clear();
+        const Format& format = formats[id - 1];
+        if (!DebugLogger::FormatMessage(entry.text, format.format.c_str(), format.signature.c_str(), payload)) break;
+        return true;
+    }
+
+    error = true;
+    return false;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file binarylog.h
+ * @brief File layout and reader for logs written with LogEncoding::Binary
+ *
+ * A binary log starts with "GFLOG\0" and a 16-bit version, followed by
+ * records in the byte order of the machine that wrote it. Every record
+ * starts with its RecordType byte:
+ *  - Format:  uint32 ID, uint32 length and format text, uint32 length and signature
+ *  - Message: int64 nanoseconds since the epoch, uint8 level, uint32 format ID,
+ *             uint32 length and payload (plain text if the ID is 0)
+ * Formats are defined once each, in ID order starting at 1, before the
+ * first message that uses them.
+ */
+#pragma once
+#include "debug_logger.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BinaryLog {
+    constexpr char kMagic[6] = {'G', 'F', 'L', 'O', 'G', '\0'};
+    constexpr std::uint16_t kVersion = 1;
+
+    enum class RecordType : std::uint8_t {
+        Format = 1,
+        Message = 2
+    };
+}
+
+class BinaryLogReader {
+public:
+    struct Entry {
+        std::int64_t timestamp = 0;  ///< Nanoseconds since the epoch
+        LogLevel level = LogLevel::Info;
+        std::string text;
+    };
+
+    /**
+     * @brief Open a binary log and check its header
+     * @return False if the file cannot be read or is not a binary log
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Read and format the next message
+     * @return False at the end of the file or on a malformed record
+     */
+    bool Next(Entry& entry);
+
+    /**
+     * @brief Whether reading stopped on a malformed or truncated record
+     */
+    [[nodiscard]] bool HasError() const { return error; }
+
+private:
+    struct Format {
+        std::string format;
+        std::string signature;
+    };
+
+    template<typename T>
+    bool Read(T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadString(std::string& text);
+
+    std::ifstream in;
+    std::uint64_t fileSize = 0;
+    std::vector<Format> formats;  ///< Indexed by format ID - 1
+    std::string payload;
+    bool error = false;
+};
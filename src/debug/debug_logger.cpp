@@ -0,0 +1,393 @@
+#include "debug_logger.h"
+#include "binarylog.h"
+#include <ctime>
+#include <iostream>
+
+namespace {
+    size_t RoundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    template<typename T>
+    bool ReadRaw(std::string_view& data, T& value) {
+        if (data.size() < sizeof(T)) return false;
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    template<typename T>
+    void WriteRaw(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::string& out, std::string_view text) {
+        WriteRaw(out, static_cast<std::uint32_t>(text.size()));
+        out.append(text.data(), text.size());
+    }
+}
+
+void DebugLogger::ThreadQueue::CopyIn(std::uint64_t position, const void* source, size_t size) {
+    const size_t offset = position & (data.size() - 1);
+    const size_t first = std::min(size, data.size() - offset);
+    std::memcpy(data.data() + offset, source, first);
+    std::memcpy(data.data(), static_cast<const char*>(source) + first, size - first);
+}
+
+void DebugLogger::ThreadQueue::CopyOut(std::uint64_t position, void* destination, size_t size) const {
+    const size_t offset = position & (data.size() - 1);
+    const size_t first = std::min(size, data.size() - offset);
+    std::memcpy(destination, data.data() + offset, first);
+    std::memcpy(static_cast<char*>(destination) + first, data.data(), size - first);
+}
+
+bool DebugLogger::ThreadQueue::TryPush(const MessageHeader& header, const char* text) {
+    const size_t size = sizeof(MessageHeader) + header.length;
+    const std::uint64_t h = head.load(std::memory_order_relaxed);
+    if (h + size - tail.load(std::memory_order_acquire) > data.size()) {
+        return false;
+    }
+
+    CopyIn(h, &header, sizeof(MessageHeader));
+    CopyIn(h + sizeof(MessageHeader), text, header.length);
+    head.store(h + size, std::memory_order_release);
+    return true;
+}
+
+template<typename Fn>
+void DebugLogger::ThreadQueue::Drain(Fn&& onMessage) {
+    std::uint64_t t = tail.load(std::memory_order_relaxed);
+    const std::uint64_t h = head.load(std::memory_order_acquire);
+
+    thread_local std::string text;
+    while (t != h) {
+        MessageHeader header;
+        CopyOut(t, &header, sizeof(MessageHeader));
+        text.resize(header.length);
+        CopyOut(t + sizeof(MessageHeader), text.data(), header.length);
+        t += sizeof(MessageHeader) + header.length;
+        onMessage(header, text);
+    }
+    tail.store(t, std::memory_order_release);
+}
+
+void DebugLogger::Initialize(const std::string& filename, const LogOptions& newOptions) {
+    Shutdown();
+
+    const bool binary = newOptions.encoding == LogEncoding::Binary;
+    logFile.open(filename, binary ? std::ios::out | std::ios::trunc | std::ios::binary
+                                  : std::ios::out | std::ios::trunc);
+    if (!logFile.is_open()) {
+        std::cerr << "Failed to open log file: " << filename << std::endl;
+        return;
+    }
+
+    if (binary) {
+        logFile.write(BinaryLog::kMagic, sizeof(BinaryLog::kMagic));
+        logFile.write(reinterpret_cast<const char*>(&BinaryLog::kVersion), sizeof(BinaryLog::kVersion));
+    }
+    formatsWritten = 0;
+
+    options = newOptions;
+    options.bufferSize = RoundUpToPowerOfTwo(std::max<size_t>(options.bufferSize, 256));
+    bufferSize.store(options.bufferSize, std::memory_order_relaxed);
+    overflow.store(options.overflow, std::memory_order_relaxed);
+    flushLevel.store(options.flushLevel, std::memory_order_relaxed);
+
+    // Drop messages pushed after the previous writer stopped; their
+    // timestamps belong to the last session. No writer runs to consume them.
+    {
+        std::lock_guard<std::mutex> lock(queuesMutex);
+        for (const auto& queue : queues) {
+            queue->tail.store(queue->head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    }
+    stopping.store(false);
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&DebugLogger::WriterLoop, this);
+
+    Log(LogLevel::Info, "Debug Logger Initialized");
+}
+
+void DebugLogger::Shutdown() {
+    if (!IsRunning()) return;
+
+    Log(LogLevel::Info, "Debug Logger Shutdown");
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping.store(true);
+    }
+    wake.notify_one();
+    writer.join();
+
+    logFile.flush();
+    logFile.close();
+}
+
+void DebugLogger::Flush() {
+    if (!IsRunning()) return;
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    const std::uint64_t request = ++flushRequested;
+    wake.notify_one();
+    flushed.wait(lock, [&] { return flushCompleted >= request || !IsRunning(); });
+}
+
+std::uint32_t DebugLogger::RegisterFormat(const char* format, const char* signature) {
+    std::lock_guard<std::mutex> lock(formatsMutex);
+    formats.push_back({format, signature});
+    return static_cast<std::uint32_t>(formats.size());
+}
+
+const DebugLogger::FormatEntry* DebugLogger::GetFormat(std::uint32_t format) {
+    if (format > writerFormats.size()) {
+        std::lock_guard<std::mutex> lock(formatsMutex);
+        writerFormats = formats;
+    }
+    return format - 1 < writerFormats.size() ? &writerFormats[format - 1] : nullptr;
+}
+
+bool DebugLogger::FormatMessage(std::string& out, const char* format, const char* signature,
+                                std::string_view payload) {
+    auto appendNext = [&](char type) {
+        switch (type) {
+            case 'b': { char value; if (!ReadRaw(payload, value)) return false; Append(out, value != 0); break; }
+            case 'c': { char value; if (!ReadRaw(payload, value)) return false; Append(out, value); break; }
+            case 'i': { std::int64_t value; if (!ReadRaw(payload, value)) return false; Append(out, value); break; }
+            case 'u': { std::uint64_t value; if (!ReadRaw(payload, value)) return false; Append(out, value); break; }
+            case 'f': { double value; if (!ReadRaw(payload, value)) return false; Append(out, value); break; }
+            case 's': {
+                std::uint32_t length;
+                if (!ReadRaw(payload, length) || payload.size() < length) return false;
+                out.append(payload.data(), length);
+                payload.remove_prefix(length);
+                break;
+            }
+            default: return false;
+        }
+        return true;
+    };
+
+    const char* text = format;
+    for (const char* type = signature; *type; ++type) {
+        const char* placeholder = std::strstr(text, "{}");
+        if (placeholder) {
+            out.append(text, placeholder);
+            text = placeholder + 2;
+        } else {
+            out.append(text);
+            text = "";
+        }
+        if (!appendNext(*type)) return false;
+    }
+    out.append(text);
+    return payload.empty();
+}
+
+DebugLogger::ThreadQueue* DebugLogger::GetThreadQueue() {
+    // Queues are never freed, so this stays valid across Shutdown() and Initialize()
+    thread_local ThreadQueue* queue = nullptr;
+    if (!queue) {
+        std::lock_guard<std::mutex> lock(queuesMutex);
+        queue = queues.emplace_back(std::make_unique<ThreadQueue>(bufferSize.load(std::memory_order_relaxed))).get();
+    }
+    return queue;
+}
+
+void DebugLogger::Push(LogLevel level, std::uint32_t format, const std::string& payload) {
+    ThreadQueue* queue = GetThreadQueue();
+    const size_t capacity = queue->data.size() - sizeof(MessageHeader);
+
+    // Text can be cut short, but an encoded payload cannot
+    if (format != 0 && payload.size() > capacity) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    MessageHeader header;
+    header.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    header.length = static_cast<std::uint32_t>(std::min(payload.size(), capacity));
+    header.format = format;
+    header.level = level;
+
+    while (!queue->TryPush(header, payload.data())) {
+        if (overflow.load(std::memory_order_relaxed) == LogOverflow::Drop || !IsRunning()) {
+            queue->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        WakeWriter();
+        std::this_thread::yield();
+    }
+
+    if (level >= flushLevel.load(std::memory_order_relaxed)) {
+        // Without the lock a wake-up can be missed; the writer's poll interval bounds the delay
+        urgentFlush.store(true, std::memory_order_relaxed);
+        WakeWriter();
+    } else if (writerSleeping.load(std::memory_order_relaxed) &&
+               queue->head.load(std::memory_order_relaxed) - queue->tail.load(std::memory_order_relaxed) >
+               queue->data.size() / 2) {
+        // Wake the writer early before a burst fills the buffer
+        WakeWriter();
+    }
+}
+
+void DebugLogger::WakeWriter() {
+    wake.notify_one();
+}
+
+void DebugLogger::WriterLoop() {
+    using Clock = std::chrono::steady_clock;
+    auto lastFlush = Clock::now();
+    // Wake regularly even without messages, bounded by the flush interval
+    const auto pollInterval = options.flushInterval.count() > 0
+        ? std::min(options.flushInterval, std::chrono::milliseconds(10))
+        : std::chrono::milliseconds(10);
+
+    for (;;) {
+        bool flushNow;
+        std::uint64_t request;
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            writerSleeping.store(true, std::memory_order_relaxed);
+            wake.wait_for(lock, pollInterval, [&] {
+                return stopping.load() || urgentFlush || flushRequested != flushCompleted;
+            });
+            writerSleeping.store(false, std::memory_order_relaxed);
+
+            stop = stopping.load();
+            request = flushRequested;
+            flushNow = urgentFlush.exchange(false) || request != flushCompleted || stop;
+        }
+
+        const bool wrote = WritePending();
+        const auto now = Clock::now();
+        if (flushNow || (wrote && (options.flushInterval.count() == 0 || now - lastFlush >= options.flushInterval))) {
+            logFile.flush();
+            if (options.console) std::cout.flush();
+            lastFlush = now;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            flushCompleted = std::max(flushCompleted, request);
+        }
+        flushed.notify_all();
+
+        if (stop) return;
+    }
+}
+
+void DebugLogger::WriteMessage(const MessageHeader& header, const std::string& payload) {
+    using namespace std::chrono;
+    const system_clock::time_point time{system_clock::duration(header.timestamp)};
+    const bool binary = options.encoding == LogEncoding::Binary;
+
+    std::string_view text = payload;
+    if (header.format != 0 && (!binary || options.console)) {
+        decoded.clear();
+        const FormatEntry* format = GetFormat(header.format);
+        if (!format || !FormatMessage(decoded, format->format, format->signature, payload)) {
+            decoded = "(malformed log message)";
+        }
+        text = decoded;
+    }
+
+    if (options.console) {
+        consoleBatch += GetLevelString(header.level);
+        consoleBatch += ": ";
+        consoleBatch.append(text.data(), text.size());
+        consoleBatch += '\n';
+    }
+
+    if (binary) {
+        // Define formats in ID order up to the one this message needs
+        while (formatsWritten < header.format) {
+            const FormatEntry* format = GetFormat(formatsWritten + 1);
+            if (!format) break;
+            WriteRaw(fileBatch, BinaryLog::RecordType::Format);
+            WriteRaw(fileBatch, ++formatsWritten);
+            WriteString(fileBatch, format->format);
+            WriteString(fileBatch, format->signature);
+        }
+
+        WriteRaw(fileBatch, BinaryLog::RecordType::Message);
+        WriteRaw(fileBatch, static_cast<std::int64_t>(duration_cast<nanoseconds>(time.time_since_epoch()).count()));
+        WriteRaw(fileBatch, static_cast<std::uint8_t>(header.level));
+        WriteRaw(fileBatch, header.format);
+        WriteString(fileBatch, payload);
+        return;
+    }
+
+    const auto sinceEpoch = duration_cast<milliseconds>(time.time_since_epoch()).count();
+    const std::int64_t second = sinceEpoch / 1000;
+
+    // localtime is slow; lines within the same second share its result
+    if (second != cachedSecond) {
+        const std::time_t seconds = static_cast<std::time_t>(second);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        std::strftime(cachedTimestamp, sizeof(cachedTimestamp), "%Y-%m-%d %H:%M:%S", &local);
+        cachedSecond = second;
+    }
+
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>(sinceEpoch % 1000));
+
+    fileBatch += cachedTimestamp;
+    fileBatch += millis;
+    fileBatch += " [";
+    fileBatch += GetLevelString(header.level);
+    fileBatch += "] ";
+    fileBatch.append(text.data(), text.size());
+    fileBatch += '\n';
+}
+
+bool DebugLogger::WritePending() {
+    fileBatch.clear();
+    consoleBatch.clear();
+
+    auto onMessage = [this](const MessageHeader& header, const std::string& payload) {
+        WriteMessage(header, payload);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(queuesMutex);
+        for (const auto& queue : queues) {
+            queue->Drain(onMessage);
+
+            const std::uint32_t dropped = queue->dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0) {
+                message = std::to_string(dropped) + " log messages dropped, buffer full";
+                onMessage({std::chrono::system_clock::now().time_since_epoch().count(), 0, 0, LogLevel::Warning},
+                          message);
+            }
+        }
+    }
+
+    if (fileBatch.empty()) return false;
+
+    logFile.write(fileBatch.data(), static_cast<std::streamsize>(fileBatch.size()));
+    if (options.console) {
+        std::cout.write(consoleBatch.data(), static_cast<std::streamsize>(consoleBatch.size()));
+    }
+    return true;
+}
+
+const char* DebugLogger::GetLevelString(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error:   return "ERROR";
+        case LogLevel::Fatal:   return "FATAL";
+        default:                return "UNKNOWN";
+    }
+}
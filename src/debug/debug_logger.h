@@ -1,12 +1,48 @@
+/**
+ * @file debug_logger.h
+ * @brief Asynchronous file and console logger
+ *
+ * Logging threads only format the message text and push it, with its level
+ * and timestamp, into a lock-free ring buffer owned by the thread. A
+ * background thread drains all buffers, formats timestamps and writes the
+ * lines to the log file and the console in batches, so a log call never
+ * takes a lock or waits on I/O.
+ *
+ * Levels below GAMEFRAMEWORK_LOG_LEVEL (0 Debug ... 3 Error) are removed at
+ * compile time: their LOG_* macros compile to nothing. Fatal is never
+ * removed. Above that floor the macros check the runtime minimum level
+ * before evaluating any argument. Arguments that are callables, e.g.
+ * [&] { return Expensive(); }, are only called for messages that are
+ * actually written.
+ *
+ * LOGF_* macros take a format string literal with {} placeholders. They
+ * register the format once per call site and queue only its ID and the raw
+ * argument bytes; the background thread formats the text. With
+ * LogEncoding::Binary the log file keeps the IDs and arguments as they are,
+ * and the gflog tool decodes it to text afterwards.
+ */
 #pragma once
-#include <string>
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <chrono>
-#include <iomanip>
-#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <memory>
-#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef GAMEFRAMEWORK_LOG_LEVEL
+#define GAMEFRAMEWORK_LOG_LEVEL 0
+#endif
 
 enum class LogLevel {
     Debug,
@@ -16,6 +52,31 @@ enum class LogLevel {
     Fatal
 };
 
+/**
+ * @brief What a log call does when its thread's buffer is full
+ */
+enum class LogOverflow {
+    Drop,   ///< Discard the message; the number dropped is logged later
+    Block   ///< Wait for the background thread to make room
+};
+
+/**
+ * @brief How messages are stored in the log file
+ */
+enum class LogEncoding {
+    Text,   ///< One formatted line per message
+    Binary  ///< Format IDs and raw arguments, decoded by BinaryLogReader or gflog
+};
+
+struct LogOptions {
+    size_t bufferSize = 64 * 1024;                    ///< Bytes per logging thread, rounded up to a power of two
+    LogOverflow overflow = LogOverflow::Drop;
+    std::chrono::milliseconds flushInterval{100};     ///< Time between file flushes, 0 to flush every batch
+    LogLevel flushLevel = LogLevel::Error;            ///< Messages at or above this are flushed right away
+    bool console = true;                              ///< Also write messages to stdout
+    LogEncoding encoding = LogEncoding::Text;
+};
+
 class DebugLogger {
 public:
     static DebugLogger& Instance() {
@@ -26,27 +87,41 @@ public:
     DebugLogger(const DebugLogger&) = delete;
     DebugLogger& operator=(const DebugLogger&) = delete;
 
-    void Initialize(const std::string& filename = "game.log") {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (logFile.is_open()) {
-            logFile.close();
-        }
-        logFile.open(filename, std::ios::out | std::ios::trunc);
-        if (!logFile.is_open()) {
-            std::cerr << "Failed to open log file: " << filename << std::endl;
-            return;
-        }
-        Log(LogLevel::Info, "Debug Logger Initialized");
-        logFile.flush();
-    }
+    /**
+     * @brief Open the log file and start the background writer
+     * Shuts down a running logger first. The buffer size applies to
+     * threads that log for the first time afterwards. Messages left in the
+     * buffers by log calls that raced with the previous Shutdown() are
+     * discarded. Other threads must not log while this runs.
+     */
+    void Initialize(const std::string& filename = "game.log", const LogOptions& options = LogOptions());
 
-    void Shutdown() {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (logFile.is_open()) {
-            Log(LogLevel::Info, "Debug Logger Shutdown");
-            logFile.flush();
-            logFile.close();
-        }
+    /**
+     * @brief Write all pending messages, stop the background writer and close the file
+     * Other threads must stop logging first; a message they log during the
+     * call may be lost.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Wait until every message logged before the call is written and flushed
+     */
+    void Flush();
+
+    [[nodiscard]] bool IsRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Set the lowest level that is written
+     * Levels removed at compile time stay removed.
+     */
+    void SetMinLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel GetMinLevel() const { return minLevel.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Check whether a message of a level would be written
+     */
+    [[nodiscard]] bool ShouldLog(LogLevel level) const {
+        return static_cast<int>(level) >= GAMEFRAMEWORK_LOG_LEVEL && level >= GetMinLevel() && IsRunning();
     }
 
     template<typename... Args>
@@ -74,62 +149,337 @@ public:
         Log(LogLevel::Fatal, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Type character of an encoded argument: b, c, i, u, f or s
+     */
+    template<typename T>
+    static constexpr char ArgType() {
+        using Value = std::decay_t<T>;
+        if constexpr (std::is_invocable_v<Value&>) {
+            return ArgType<std::invoke_result_t<Value&>>();
+        } else if constexpr (std::is_same_v<Value, bool>) {
+            return 'b';
+        } else if constexpr (std::is_same_v<Value, char> || std::is_same_v<Value, signed char> ||
+                             std::is_same_v<Value, unsigned char>) {
+            return 'c';
+        } else if constexpr (std::is_integral_v<Value>) {
+            return std::is_signed_v<Value> ? 'i' : 'u';
+        } else if constexpr (std::is_floating_point_v<Value>) {
+            return 'f';
+        } else {
+            return 's';
+        }
+    }
+
+    /**
+     * @brief Argument types of a format call, one character per argument
+     * Only used in unevaluated context, to read value without evaluating arguments.
+     */
+    template<typename... Args>
+    struct Signature {
+        static constexpr char value[] = {ArgType<Args>()..., '\0'};
+    };
+
+    template<typename... Args>
+    static Signature<Args...> SignatureOf(const char* format, const Args&... args);
+
+    /**
+     * @brief Register a format string, returning its ID
+     * Both strings must outlive the logger; LOGF_* call this once per call site.
+     */
+    std::uint32_t RegisterFormat(const char* format, const char* signature);
+
+    /**
+     * @brief Queue a message of a registered format without formatting it
+     * Called by the LOGF_* macros after ShouldLog().
+     */
+    template<typename... Args>
+    void LogFormat(LogLevel level, std::uint32_t format, const char* /*formatString*/, Args&&... args) {
+        thread_local std::string payload;
+        payload.clear();
+        (Encode(payload, std::forward<Args>(args)), ...);
+        Push(level, format, payload);
+    }
+
+    /**
+     * @brief Substitute encoded arguments into a format string
+     * Arguments without a placeholder are appended at the end.
+     * @return False if the payload does not match the signature
+     */
+    static bool FormatMessage(std::string& out, const char* format, const char* signature, std::string_view payload);
+
+    static const char* GetLevelString(LogLevel level);
+
 private:
+    /**
+     * @brief Fixed part of a queued message; the text follows it
+     */
+    struct MessageHeader {
+        std::int64_t timestamp;  ///< system_clock ticks
+        std::uint32_t length;
+        std::uint32_t format;    ///< Registered format ID, or 0 for preformatted text
+        LogLevel level;
+    };
+
+    struct FormatEntry {
+        const char* format;
+        const char* signature;
+    };
+
+    /**
+     * @brief Single-producer single-consumer byte ring of queued messages
+     */
+    struct ThreadQueue {
+        explicit ThreadQueue(size_t capacity) : data(capacity) {}
+
+        bool TryPush(const MessageHeader& header, const char* text);
+        /**
+         * @brief Pop every queued message, passing its header and text to onMessage
+         */
+        template<typename Fn>
+        void Drain(Fn&& onMessage);
+
+        std::vector<char> data;
+        std::atomic<std::uint64_t> head{0};    ///< Bytes written, owned by the producer
+        std::atomic<std::uint64_t> tail{0};    ///< Bytes read, owned by the consumer
+        std::atomic<std::uint32_t> dropped{0};
+
+    private:
+        void CopyIn(std::uint64_t position, const void* source, size_t size);
+        void CopyOut(std::uint64_t position, void* destination, size_t size) const;
+    };
+
     DebugLogger() = default;
     ~DebugLogger() {
         Shutdown();
     }
 
+    template<typename T>
+    static void Append(std::string& out, T&& value) {
+        using Value = std::decay_t<T>;
+        if constexpr (std::is_array_v<std::remove_reference_t<T>>) {
+            out.append(value);
+        } else if constexpr (std::is_invocable_v<Value&>) {
+            // Deferred argument, evaluated only for written messages
+            Append(out, value());
+        } else if constexpr (std::is_same_v<Value, std::string> || std::is_same_v<Value, std::string_view>) {
+            out.append(value.data(), value.size());
+        } else if constexpr (std::is_same_v<Value, const char*> || std::is_same_v<Value, char*>) {
+            out.append(value ? value : "(null)");
+        } else if constexpr (std::is_same_v<Value, bool>) {
+            out.push_back(value ? '1' : '0');
+        } else if constexpr (std::is_same_v<Value, char> || std::is_same_v<Value, signed char> ||
+                             std::is_same_v<Value, unsigned char>) {
+            out.push_back(static_cast<char>(value));
+        } else if constexpr (std::is_integral_v<Value>) {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            out.append(digits, result.ptr);
+        } else if constexpr (std::is_floating_point_v<Value>) {
+            // Same output as the default ostream formatting
+            char digits[32];
+            int length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+            out.append(digits, static_cast<size_t>(std::max(length, 0)));
+        } else {
+            thread_local std::ostringstream stream;
+            stream.str(std::string());
+            stream << std::forward<T>(value);
+            out += stream.str();
+        }
+    }
+
+    /**
+     * @brief Append an argument's raw bytes as described by ArgType()
+     * Numbers widen to 64 bits; strings and other types are stored as a
+     * 32-bit length followed by their text.
+     */
+    template<typename T>
+    static void Encode(std::string& out, T&& value) {
+        using Value = std::decay_t<T>;
+        constexpr char type = ArgType<T>();
+        if constexpr (std::is_invocable_v<Value&>) {
+            Encode(out, value());
+        } else if constexpr (type == 'b' || type == 'c') {
+            out.push_back(static_cast<char>(value));
+        } else if constexpr (type == 'i') {
+            EncodeRaw(out, static_cast<std::int64_t>(value));
+        } else if constexpr (type == 'u') {
+            EncodeRaw(out, static_cast<std::uint64_t>(value));
+        } else if constexpr (type == 'f') {
+            EncodeRaw(out, static_cast<double>(value));
+        } else {
+            const size_t start = out.size();
+            EncodeRaw(out, std::uint32_t(0));
+            Append(out, std::forward<T>(value));
+            const auto length = static_cast<std::uint32_t>(out.size() - start - sizeof(std::uint32_t));
+            std::memcpy(&out[start], &length, sizeof(length));
+        }
+    }
+
+    template<typename T>
+    static void EncodeRaw(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
     template<typename... Args>
     void Log(LogLevel level, Args&&... args) {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (!logFile.is_open()) return;
+        if (!ShouldLog(level)) return;
 
-        std::stringstream ss;
-        (ss << ... << std::forward<Args>(args));
+        thread_local std::string text;
+        text.clear();
+        (Append(text, std::forward<Args>(args)), ...);
+        Push(level, 0, text);
+    }
 
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
+    /**
+     * @brief Queue a message on the calling thread's buffer
+     * @param format Registered format ID of an encoded payload, 0 for text
+     */
+    void Push(LogLevel level, std::uint32_t format, const std::string& payload);
 
-        logFile << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S")
-                << '.' << std::setfill('0') << std::setw(3) << ms.count()
-                << " [" << GetLevelString(level) << "] "
-                << ss.str() << std::endl;
-        logFile.flush();
+    ThreadQueue* GetThreadQueue();
+    void WriterLoop();
 
-        // Also output to console
-        std::cout << GetLevelString(level) << ": " << ss.str() << std::endl;
-    }
+    /**
+     * @brief Drain every queue into the file and console
+     * @return True if anything was written
+     */
+    bool WritePending();
 
-    const char* GetLevelString(LogLevel level) {
-        switch (level) {
-            case LogLevel::Debug:   return "DEBUG";
-            case LogLevel::Info:    return "INFO";
-            case LogLevel::Warning: return "WARNING";
-            case LogLevel::Error:   return "ERROR";
-            case LogLevel::Fatal:   return "FATAL";
-            default:                return "UNKNOWN";
-        }
-    }
+    void WakeWriter();
+
+    /**
+     * @brief Append a message to the batches in the configured encoding
+     */
+    void WriteMessage(const MessageHeader& header, const std::string& payload);
+
+    /**
+     * @brief Look up a format on the writer thread
+     */
+    const FormatEntry* GetFormat(std::uint32_t format);
 
     std::ofstream logFile;
-    std::mutex mutex;
+    LogOptions options;  ///< Writer thread only; producers read the atomic copies below
+
+    // Options read by logging threads, set by Initialize()
+    std::atomic<size_t> bufferSize{LogOptions().bufferSize};
+    std::atomic<LogOverflow> overflow{LogOptions().overflow};
+    std::atomic<LogLevel> flushLevel{LogOptions().flushLevel};
+    std::atomic<LogLevel> minLevel{LogLevel::Debug};
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    std::mutex queuesMutex;  ///< Guards queues; only taken on thread registration and by the writer
+    std::vector<std::unique_ptr<ThreadQueue>> queues;
+
+    std::mutex formatsMutex;
+    std::vector<FormatEntry> formats;  ///< Indexed by format ID - 1, never shrinks
+
+    // Writer wake-up and Flush() handshake
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::atomic<bool> writerSleeping{false};
+    std::uint64_t flushRequested = 0;
+    std::uint64_t flushCompleted = 0;
+    std::atomic<bool> urgentFlush{false};  ///< Set by messages at or above flushLevel
+
+    // Writer-only state
+    std::string fileBatch;
+    std::string consoleBatch;
+    std::string message;
+    std::string decoded;
+    std::vector<FormatEntry> writerFormats;  ///< Copy of formats, refreshed on unknown IDs
+    std::uint32_t formatsWritten = 0;        ///< Formats defined in the current binary file
+    std::int64_t cachedSecond = -1;
+    char cachedTimestamp[32] = {};
 };
 
-// Convenience macros
-#define LOG_DEBUG(...) DebugLogger::Instance().Debug(__VA_ARGS__)
-#define LOG_INFO(...) DebugLogger::Instance().Info(__VA_ARGS__)
-#define LOG_WARNING(...) DebugLogger::Instance().Warning(__VA_ARGS__)
-#define LOG_ERROR(...) DebugLogger::Instance().Error(__VA_ARGS__)
-#define LOG_FATAL(...) DebugLogger::Instance().Fatal(__VA_ARGS__)
+// Convenience macros; arguments are only evaluated if the message is written
+#define GAMEFRAMEWORK_LOG_IF(level, ...) \
+    do { \
+        DebugLogger& logger_ = DebugLogger::Instance(); \
+        if (logger_.ShouldLog(LogLevel::level)) logger_.level(__VA_ARGS__); \
+    } while (false)
+
+// Removed levels still type-check their arguments but never evaluate them
+#define GAMEFRAMEWORK_LOG_REMOVED(level, ...) \
+    do { \
+        if (false) DebugLogger::Instance().level(__VA_ARGS__); \
+    } while (false)
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 0
+#define LOG_DEBUG(...) GAMEFRAMEWORK_LOG_IF(Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) GAMEFRAMEWORK_LOG_REMOVED(Debug, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 1
+#define LOG_INFO(...) GAMEFRAMEWORK_LOG_IF(Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) GAMEFRAMEWORK_LOG_REMOVED(Info, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 2
+#define LOG_WARNING(...) GAMEFRAMEWORK_LOG_IF(Warning, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) GAMEFRAMEWORK_LOG_REMOVED(Warning, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 3
+#define LOG_ERROR(...) GAMEFRAMEWORK_LOG_IF(Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) GAMEFRAMEWORK_LOG_REMOVED(Error, __VA_ARGS__)
+#endif
+
+#define LOG_FATAL(...) GAMEFRAMEWORK_LOG_IF(Fatal, __VA_ARGS__)
+
+// Format macros, e.g. LOGF_INFO("Spawned {} at {}", id, position); the format must be a string literal
+#define GAMEFRAMEWORK_LOGF_FORMAT(format, ...) format ""
+#define GAMEFRAMEWORK_LOGF_EXPAND(x) x  // Splits __VA_ARGS__ on MSVC's traditional preprocessor too
+#define GAMEFRAMEWORK_LOGF_IF(level, ...) \
+    do { \
+        DebugLogger& logger_ = DebugLogger::Instance(); \
+        if (logger_.ShouldLog(LogLevel::level)) { \
+            static const std::uint32_t format_ = logger_.RegisterFormat( \
+                GAMEFRAMEWORK_LOGF_EXPAND(GAMEFRAMEWORK_LOGF_FORMAT(__VA_ARGS__, 0)), \
+                decltype(DebugLogger::SignatureOf(__VA_ARGS__))::value); \
+            logger_.LogFormat(LogLevel::level, format_, __VA_ARGS__); \
+        } \
+    } while (false)
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 0
+#define LOGF_DEBUG(...) GAMEFRAMEWORK_LOGF_IF(Debug, __VA_ARGS__)
+#else
+#define LOGF_DEBUG(...) GAMEFRAMEWORK_LOG_REMOVED(Debug, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 1
+#define LOGF_INFO(...) GAMEFRAMEWORK_LOGF_IF(Info, __VA_ARGS__)
+#else
+#define LOGF_INFO(...) GAMEFRAMEWORK_LOG_REMOVED(Info, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 2
+#define LOGF_WARNING(...) GAMEFRAMEWORK_LOGF_IF(Warning, __VA_ARGS__)
+#else
+#define LOGF_WARNING(...) GAMEFRAMEWORK_LOG_REMOVED(Warning, __VA_ARGS__)
+#endif
+
+#if GAMEFRAMEWORK_LOG_LEVEL <= 3
+#define LOGF_ERROR(...) GAMEFRAMEWORK_LOGF_IF(Error, __VA_ARGS__)
+#else
+#define LOGF_ERROR(...) GAMEFRAMEWORK_LOG_REMOVED(Error, __VA_ARGS__)
+#endif
+
+#define LOGF_FATAL(...) GAMEFRAMEWORK_LOGF_IF(Fatal, __VA_ARGS__)
 
 class ScopeTimer {
 public:
-    ScopeTimer(const char* name) 
+    ScopeTimer(const char* name)
         : name(name), start(std::chrono::high_resolution_clock::now()) {}
-    
+
     ~ScopeTimer() {
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -141,4 +491,8 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> start;
 };
 
+#if GAMEFRAMEWORK_LOG_LEVEL <= 0
 #define SCOPE_TIMER(name) ScopeTimer timer##__LINE__(name)
+#else
+#define SCOPE_TIMER(name) ((void)0)
+#endif
@@ -0,0 +1,179 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    void AtomicAdd(std::atomic<double>& target, double amount) {
+        double current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {}
+    }
+
+    template<typename Compare>
+    void AtomicUpdate(std::atomic<double>& target, double value, Compare better) {
+        double current = target.load(std::memory_order_relaxed);
+        while (better(value, current) &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+}
+
+void Metrics::Gauge::Add(double amount) {
+    AtomicAdd(value, amount);
+}
+
+size_t Metrics::Histogram::GetBucket(double value) {
+    if (!(value >= std::ldexp(1.0, kMinExponent))) return 0;
+
+    // value = mantissa * 2^exponent with mantissa in [0.5, 1)
+    int exponent = 0;
+    const double mantissa = std::frexp(value, &exponent);
+    const int octave = exponent - 1 - kMinExponent;
+    if (octave >= kMaxExponent - kMinExponent) return kBucketCount - 1;
+
+    const int sub = static_cast<int>((mantissa * 2.0 - 1.0) * kSubBuckets);
+    return 1 + static_cast<size_t>(octave) * kSubBuckets + static_cast<size_t>(sub);
+}
+
+double Metrics::Histogram::GetBucketValue(size_t bucket) {
+    if (bucket == 0) return 0.0;
+
+    const size_t index = bucket - 1;
+    const int exponent = static_cast<int>(index / kSubBuckets) + kMinExponent;
+    const double sub = static_cast<double>(index % kSubBuckets) + 0.5;
+    return std::ldexp(1.0 + sub / kSubBuckets, exponent);
+}
+
+void Metrics::Histogram::Record(double value) {
+    buckets[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    AtomicAdd(sum, value);
+    AtomicUpdate(min, value, [](double a, double b) { return a < b; });
+    AtomicUpdate(max, value, [](double a, double b) { return a > b; });
+    count.fetch_add(1, std::memory_order_relaxed);
+}
+
+double Metrics::Histogram::GetMin() const {
+    return GetCount() > 0 ? min.load(std::memory_order_relaxed) : 0.0;
+}
+
+double Metrics::Histogram::GetMax() const {
+    return GetCount() > 0 ? max.load(std::memory_order_relaxed) : 0.0;
+}
+
+Metrics::Histogram::Snapshot Metrics::Histogram::GetSnapshot() const {
+    Snapshot snapshot;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = sum.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void Metrics::Histogram::Reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0.0, std::memory_order_relaxed);
+    min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+    max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+}
+
+double Metrics::Histogram::Snapshot::Percentile(double percent) const {
+    if (count == 0) return 0.0;
+
+    const double rank = std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(count);
+    const auto target = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(rank)), 1);
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= target) return GetBucketValue(i);
+    }
+    return GetBucketValue(kBucketCount - 1);
+}
+
+Metrics::Histogram::Snapshot Metrics::Histogram::Snapshot::Since(const Snapshot& earlier) const {
+    Snapshot result;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        result.buckets[i] = buckets[i] - std::min(earlier.buckets[i], buckets[i]);
+        result.count += result.buckets[i];
+    }
+    result.sum = sum - earlier.sum;
+    return result;
+}
+
+template<typename T>
+T* Metrics::Find(const std::vector<std::unique_ptr<T>>& metrics, std::string_view name) {
+    for (const auto& metric : metrics) {
+        if (metric->GetName() == name) return metric.get();
+    }
+    return nullptr;
+}
+
+Metrics::Counter& Metrics::GetCounter(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Counter* counter = Find(counters, name)) return *counter;
+
+    registered.push_back({std::string(name), Type::Counter});
+    return *counters.emplace_back(std::make_unique<Counter>(std::string(name)));
+}
+
+Metrics::Gauge& Metrics::GetGauge(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Gauge* gauge = Find(gauges, name)) return *gauge;
+
+    registered.push_back({std::string(name), Type::Gauge});
+    return *gauges.emplace_back(std::make_unique<Gauge>(std::string(name)));
+}
+
+Metrics::Histogram& Metrics::GetHistogram(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Histogram* histogram = Find(histograms, name)) return *histogram;
+
+    registered.push_back({std::string(name), Type::Histogram});
+    return *histograms.emplace_back(std::make_unique<Histogram>(std::string(name)));
+}
+
+const Metrics::Counter* Metrics::FindCounter(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Find(counters, name);
+}
+
+const Metrics::Gauge* Metrics::FindGauge(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Find(gauges, name);
+}
+
+const Metrics::Histogram* Metrics::FindHistogram(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Find(histograms, name);
+}
+
+std::vector<Metrics::Info> Metrics::List() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return registered;
+}
+
+void Metrics::EndFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& counter : counters) {
+        const std::uint64_t total = counter->GetTotal();
+        counter->frameValue.store(total - counter->frameStart, std::memory_order_relaxed);
+        counter->frameStart = total;
+    }
+}
+
+void Metrics::Reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& counter : counters) {
+        counter->total.store(0, std::memory_order_relaxed);
+        counter->frameValue.store(0, std::memory_order_relaxed);
+        counter->frameStart = 0;
+    }
+    for (const auto& gauge : gauges) {
+        gauge->Set(0.0);
+    }
+    for (const auto& histogram : histograms) {
+        histogram->Reset();
+    }
+}
@@ -0,0 +1,214 @@
+/**
+ * @file metrics.h
+ * @brief Runtime counters, gauges and histograms
+ *
+ * Metrics are registered by name and live as long as the program, so call
+ * sites look them up once and keep the reference. Recording is a relaxed
+ * atomic operation and safe from any thread; histograms use fixed buckets
+ * and never allocate or lock.
+ *
+ * Metrics published by the framework:
+ *  - frame.time_ms (histogram), frame.fps (gauge)
+ *  - scene.objects, scene.objects_updated, scene.collisions (gauges)
+ *  - scene.collision_pairs (counter): object pairs tested for collision
+ *  - render.draw_calls (counter): sprites, particle batches and retained frame copies
+ *  - assets.<type>.count, .bytes, .hit_rate (gauges) for textures, sounds, music and sheets
+ *  - assets.pending_loads (gauge)
+ *  - audio.sounds_played (counter), audio.channels_playing (gauge)
+ */
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Metrics {
+public:
+    /**
+     * @brief Monotonic count of events
+     */
+    class Counter {
+    public:
+        explicit Counter(std::string name) : name(std::move(name)) {}
+
+        void Add(std::uint64_t amount = 1) { total.fetch_add(amount, std::memory_order_relaxed); }
+
+        [[nodiscard]] std::uint64_t GetTotal() const { return total.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Amount added during the last frame ended with Metrics::EndFrame()
+         */
+        [[nodiscard]] std::uint64_t GetFrameValue() const { return frameValue.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] const std::string& GetName() const { return name; }
+
+    private:
+        friend class Metrics;
+
+        const std::string name;
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> frameValue{0};
+        std::uint64_t frameStart = 0;  ///< Total when the current frame began, main thread only
+    };
+
+    /**
+     * @brief Latest value of a quantity
+     */
+    class Gauge {
+    public:
+        explicit Gauge(std::string name) : name(std::move(name)) {}
+
+        void Set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+        void Add(double amount);
+
+        [[nodiscard]] double Get() const { return value.load(std::memory_order_relaxed); }
+        [[nodiscard]] const std::string& GetName() const { return name; }
+
+    private:
+        const std::string name;
+        std::atomic<double> value{0.0};
+    };
+
+    /**
+     * @brief Distribution of recorded values in log-linear buckets
+     *
+     * Each power of two between 2^kMinExponent and 2^kMaxExponent is split
+     * into kSubBuckets equal buckets, so percentiles are within about 3% of
+     * the true value. Smaller values share the first bucket and larger ones
+     * the last.
+     */
+    class Histogram {
+    public:
+        static constexpr int kSubBuckets = 16;
+        static constexpr int kMinExponent = -10;
+        static constexpr int kMaxExponent = 22;
+        static constexpr size_t kBucketCount = 1 + (kMaxExponent - kMinExponent) * kSubBuckets;
+
+        /**
+         * @brief Copy of the bucket counts at one point in time
+         */
+        struct Snapshot {
+            std::array<std::uint64_t, kBucketCount> buckets{};
+            std::uint64_t count = 0;
+            double sum = 0.0;
+
+            /**
+             * @brief Value below which the given percent of recorded values fall
+             * @param percent 0 to 100
+             * @return Middle of the bucket holding that value, 0 if empty
+             */
+            [[nodiscard]] double Percentile(double percent) const;
+
+            [[nodiscard]] double Mean() const { return count > 0 ? sum / count : 0.0; }
+
+            /**
+             * @brief Values recorded between an earlier snapshot and this one
+             */
+            [[nodiscard]] Snapshot Since(const Snapshot& earlier) const;
+        };
+
+        explicit Histogram(std::string name) : name(std::move(name)) {}
+
+        void Record(double value);
+
+        [[nodiscard]] Snapshot GetSnapshot() const;
+        [[nodiscard]] std::uint64_t GetCount() const { return count.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Exact extremes of all recorded values, 0 if none
+         */
+        [[nodiscard]] double GetMin() const;
+        [[nodiscard]] double GetMax() const;
+        [[nodiscard]] const std::string& GetName() const { return name; }
+
+        /**
+         * @brief Bucket a value is counted in
+         */
+        static size_t GetBucket(double value);
+
+        /**
+         * @brief Value a bucket stands for in percentiles
+         */
+        static double GetBucketValue(size_t bucket);
+
+    private:
+        friend class Metrics;
+
+        void Reset();
+
+        const std::string name;
+        std::array<std::atomic<std::uint64_t>, kBucketCount> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<double> sum{0.0};
+        std::atomic<double> min{std::numeric_limits<double>::infinity()};
+        std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+    };
+
+    enum class Type {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Info {
+        std::string name;
+        Type type;
+    };
+
+    static Metrics& Instance() {
+        static Metrics instance;
+        return instance;
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    /**
+     * @brief Get a metric by name, registering it on first use
+     * The reference stays valid for the lifetime of the program.
+     */
+    Counter& GetCounter(std::string_view name);
+    Gauge& GetGauge(std::string_view name);
+    Histogram& GetHistogram(std::string_view name);
+
+    /**
+     * @brief Look up a registered metric
+     * @return The metric, or nullptr if nothing registered it yet
+     */
+    [[nodiscard]] const Counter* FindCounter(std::string_view name) const;
+    [[nodiscard]] const Gauge* FindGauge(std::string_view name) const;
+    [[nodiscard]] const Histogram* FindHistogram(std::string_view name) const;
+
+    /**
+     * @brief Names and types of all registered metrics, in registration order
+     */
+    [[nodiscard]] std::vector<Info> List() const;
+
+    /**
+     * @brief Close the current frame for counter frame values
+     * Called by Game once per frame.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Zero every metric, keeping registrations and references valid
+     */
+    void Reset();
+
+private:
+    Metrics() = default;
+
+    template<typename T>
+    static T* Find(const std::vector<std::unique_ptr<T>>& metrics, std::string_view name);
+
+    mutable std::mutex mutex;  ///< Guards registration; recording never takes it
+    std::vector<std::unique_ptr<Counter>> counters;
+    std::vector<std::unique_ptr<Gauge>> gauges;
+    std::vector<std::unique_ptr<Histogram>> histograms;
+    std::vector<Info> registered;
+};
@@ -0,0 +1,263 @@
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    bool SameName(const char* a, const char* b) {
+        return a == b || std::strcmp(a, b) == 0;
+    }
+}
+
+const Profiler::ZoneStats* Profiler::FrameStats::Find(std::string_view name) const {
+    for (const ZoneStats& zone : zones) {
+        if (name == zone.name) return &zone;
+    }
+    return nullptr;
+}
+
+Profiler::Profiler()
+    : baseTicks(ReadTicks()),
+      baseTime(std::chrono::steady_clock::now()),
+      frameStartTicks(baseTicks) {}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+    // Buffers are never freed, so this stays valid after the thread exits
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        auto& added = buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        added->index = static_cast<std::uint32_t>(buffers.size() - 1);
+        buffer = added.get();
+    }
+    return buffer;
+}
+
+void Profiler::RecordCounter(const char* name, double value) {
+    if (!IsEnabled()) return;
+
+    ZoneRecord record;
+    record.name = name;
+    record.start = ReadTicks();
+    record.value = value;
+    record.depth = kCounterDepth;
+    GetThreadBuffer()->Push(record);
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffer->name = name;
+}
+
+const char* Profiler::GetThreadName(std::uint32_t thread) const {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    return thread < buffers.size() ? buffers[thread]->name : nullptr;
+}
+
+void Profiler::EndFrame() {
+    const std::uint64_t now = ReadTicks();
+
+#ifdef GAMEFRAMEWORK_PROFILER_RDTSC
+    // Recalibrate every frame; the estimate sharpens as the measured span grows
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - baseTime).count();
+    if (elapsedMs > 1.0) {
+        ticksPerMs = (now - baseTicks) / elapsedMs;
+    }
+#endif
+
+    FrameStats frame;
+    frame.frame = frameCount++;
+    frame.durationMs = TicksToMs(now - frameStartTicks);
+
+    const bool capturing = capture.IsOpen() || spikeThresholdMs > 0.0;
+    CapturedFrame captured{frame.frame, frameStartTicks, now, {}};
+    frameStartTicks = now;
+
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        threadNames.resize(buffers.size());
+        for (const auto& buffer : buffers) {
+            threadNames[buffer->index] = buffer->name;
+            scratch.clear();
+            const std::uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+            const std::uint32_t head = buffer->head.load(std::memory_order_acquire);
+            for (std::uint32_t i = tail; i != head; ++i) {
+                scratch.push_back(buffer->records[i & (kBufferCapacity - 1)]);
+            }
+            buffer->tail.store(head, std::memory_order_release);
+            frame.droppedZones += buffer->dropped.exchange(0, std::memory_order_relaxed);
+
+            if (capturing) {
+                for (const ZoneRecord& record : scratch) {
+                    captured.records.emplace_back(buffer->index, record);
+                }
+            }
+            if (!scratch.empty()) {
+                AddThreadZones(buffer->index, scratch, frame);
+            }
+        }
+    }
+
+    if (capturing) {
+        CaptureFrame(std::move(captured), frame.durationMs);
+    }
+
+    lastFrame = frame;
+    history.push_back(std::move(frame));
+    while (history.size() > historySize) {
+        history.pop_front();
+    }
+}
+
+void Profiler::AddThreadZones(std::uint32_t thread, std::vector<ZoneRecord>& records, FrameStats& frame) const {
+    // Keep the last sample of each counter and drop counters from the zones
+    size_t zoneCount = 0;
+    for (const ZoneRecord& record : records) {
+        if (record.depth != kCounterDepth) {
+            records[zoneCount++] = record;
+            continue;
+        }
+
+        auto it = std::find_if(frame.counters.begin(), frame.counters.end(),
+            [&](const CounterStats& counter) { return SameName(counter.name, record.name); });
+        if (it != frame.counters.end()) {
+            it->value = record.value;
+        } else {
+            frame.counters.push_back({record.name, record.value});
+        }
+    }
+    records.resize(zoneCount);
+
+    // Zones are pushed when they end, so children arrive before their parents.
+    // Sorting by start time (outer zone first on ties) restores nesting order.
+    std::sort(records.begin(), records.end(), [](const ZoneRecord& a, const ZoneRecord& b) {
+        return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+    });
+
+    const size_t first = frame.zones.size();
+    std::vector<std::uint64_t> totalTicks;
+    std::vector<std::uint64_t> childTicks;
+    std::vector<std::int32_t> stack;  ///< Open zone per depth
+
+    for (const ZoneRecord& record : records) {
+        if (stack.size() > record.depth) {
+            stack.resize(record.depth);
+        }
+        const std::int32_t parent = stack.empty() ? -1 : stack.back();
+
+        // Merge repeated calls at the same place in the tree
+        std::int32_t node = -1;
+        for (size_t i = first; i < frame.zones.size(); ++i) {
+            if (frame.zones[i].parent == parent && SameName(frame.zones[i].name, record.name)) {
+                node = static_cast<std::int32_t>(i);
+                break;
+            }
+        }
+        if (node < 0) {
+            node = static_cast<std::int32_t>(frame.zones.size());
+            frame.zones.push_back({record.name, thread, static_cast<std::uint32_t>(stack.size()), parent});
+            totalTicks.push_back(0);
+            childTicks.push_back(0);
+        }
+
+        const std::uint64_t ticks = record.end - record.start;
+        ++frame.zones[node].calls;
+        totalTicks[node - first] += ticks;
+        if (parent >= 0) {
+            childTicks[parent - first] += ticks;
+        }
+        stack.push_back(node);
+    }
+
+    for (size_t i = 0; i < totalTicks.size(); ++i) {
+        ZoneStats& zone = frame.zones[first + i];
+        zone.totalMs = TicksToMs(totalTicks[i]);
+        zone.selfMs = TicksToMs(totalTicks[i] - std::min(childTicks[i], totalTicks[i]));
+    }
+}
+
+void Profiler::WriteFrame(TraceWriter& writer, const CapturedFrame& frame) const {
+    for (std::uint32_t thread = 0; thread < threadNames.size(); ++thread) {
+        writer.WriteThreadName(thread, threadNames[thread]);
+    }
+
+    const double frameStartUs = TicksToUs(frame.start);
+    writer.WriteFrameMarker(frame.frame, frameStartUs);
+    writer.WriteCounter("Frame time (ms)", frameStartUs, TicksToMs(frame.end - frame.start));
+
+    for (const auto& [thread, record] : frame.records) {
+        if (record.depth == kCounterDepth) {
+            writer.WriteCounter(record.name, TicksToUs(record.start), record.value);
+        } else {
+            writer.WriteZone(thread, record.name, TicksToUs(record.start),
+                             TicksToMs(record.end - record.start) * 1000.0);
+        }
+    }
+}
+
+void Profiler::CaptureFrame(CapturedFrame&& frame, double durationMs) {
+    if (capture.IsOpen()) {
+        WriteFrame(capture, frame);
+        if (captureFramesLeft > 0 && --captureFramesLeft == 0) {
+            StopCapture();
+        }
+    }
+
+    if (spikeThresholdMs <= 0.0) return;
+
+    if (durationMs > spikeThresholdMs) {
+        TraceWriter spike;
+        if (spike.Open(spikePathPrefix + "_frame" + std::to_string(frame.frame) + ".json")) {
+            for (const CapturedFrame& recent : recentFrames) {
+                WriteFrame(spike, recent);
+            }
+            WriteFrame(spike, frame);
+        }
+        recentFrames.clear();
+        return;
+    }
+
+    if (spikeFramesBefore == 0) return;
+    recentFrames.push_back(std::move(frame));
+    while (recentFrames.size() > spikeFramesBefore) {
+        recentFrames.pop_front();
+    }
+}
+
+bool Profiler::StartCapture(const std::string& path, std::uint32_t frames) {
+    captureFramesLeft = frames;
+    return capture.Open(path);
+}
+
+void Profiler::StopCapture() {
+    capture.Close();
+}
+
+void Profiler::SetSpikeCapture(double thresholdMs, const std::string& pathPrefix, std::uint32_t framesBefore) {
+    spikeThresholdMs = thresholdMs;
+    spikePathPrefix = pathPrefix;
+    spikeFramesBefore = framesBefore;
+    recentFrames.clear();
+}
+
+void Profiler::SetHistorySize(size_t frames) {
+    historySize = std::max<size_t>(frames, 1);
+    while (history.size() > historySize) {
+        history.pop_front();
+    }
+}
+
+void Profiler::Reset() {
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (const auto& buffer : buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    history.clear();
+    recentFrames.clear();
+    lastFrame = FrameStats();
+    frameStartTicks = ReadTicks();
+}
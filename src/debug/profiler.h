@@ -0,0 +1,330 @@
+/**
+ * @file profiler.h
+ * @brief Low-overhead hierarchical frame profiler
+ *
+ * Code marks zones with PROFILE_ZONE("name"). A zone reads the CPU
+ * timestamp counter when it starts and ends and pushes one record into a
+ * ring buffer owned by the current thread, so recording takes no locks and
+ * does no I/O. Once per frame, PROFILE_FRAME() drains every thread's buffer
+ * and merges the records into a tree of per-zone call counts and times.
+ *
+ * PROFILE_COUNTER("name", value) samples a value the same way; counters
+ * appear in the frame's results and in trace captures.
+ *
+ * Captures stream the raw zones of each frame to a Chrome trace-event JSON
+ * file, which chrome://tracing and the Perfetto UI open directly. They are
+ * started on demand with StartCapture() or automatically for frames slower
+ * than a threshold with SetSpikeCapture().
+ *
+ * The macros compile to nothing unless GAMEFRAMEWORK_PROFILER is defined
+ * (CMake option GAMEFRAMEWORK_ENABLE_PROFILER). The Profiler class itself
+ * is always available, so tools reading its results build either way.
+ */
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "tracewriter.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define GAMEFRAMEWORK_PROFILER_RDTSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define GAMEFRAMEWORK_PROFILER_RDTSC 1
+#endif
+
+class Profiler {
+public:
+    /**
+     * @brief Times of one zone, merged over all its calls in a frame
+     */
+    struct ZoneStats {
+        const char* name;
+        std::uint32_t thread;     ///< Index of the recording thread, in order of first use
+        std::uint32_t depth;      ///< 0 for zones not nested in another zone
+        std::int32_t parent;      ///< Index of the enclosing zone in FrameStats::zones, or -1
+        std::uint32_t calls = 0;
+        double totalMs = 0.0;     ///< Including nested zones
+        double selfMs = 0.0;      ///< Excluding nested zones
+    };
+
+    /**
+     * @brief Last value of a counter in a frame
+     */
+    struct CounterStats {
+        const char* name;
+        double value;
+    };
+
+    /**
+     * @brief Zones recorded during one frame; parents precede their children
+     */
+    struct FrameStats {
+        std::uint64_t frame = 0;
+        double durationMs = 0.0;         ///< Time since the previous EndFrame()
+        std::uint32_t droppedZones = 0;  ///< Zones lost to full ring buffers
+        std::vector<ZoneStats> zones;
+        std::vector<CounterStats> counters;
+
+        /**
+         * @brief Find the first zone with a name
+         * @return The zone, or nullptr if it was not recorded this frame
+         */
+        [[nodiscard]] const ZoneStats* Find(std::string_view name) const;
+    };
+
+    static Profiler& Instance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Read the profiler's clock
+     * @return Timestamp counter on x86, steady clock nanoseconds elsewhere
+     */
+    static std::uint64_t ReadTicks() {
+#ifdef GAMEFRAMEWORK_PROFILER_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Start or stop recording zones
+     * Zones that are already open when recording stops are still recorded.
+     */
+    void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Sample a counter from any thread
+     * @param name Counter name; must outlive the profiler, e.g. a literal
+     */
+    void RecordCounter(const char* name, double value);
+
+    /**
+     * @brief Name the calling thread in the results
+     * @param name String that outlives the profiler, e.g. a literal
+     */
+    void SetThreadName(const char* name);
+    [[nodiscard]] const char* GetThreadName(std::uint32_t thread) const;
+
+    /**
+     * @brief Collect the zones recorded since the last call into a new frame
+     * Call once per frame from the main thread.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Get the most recently collected frame
+     */
+    [[nodiscard]] const FrameStats& GetLastFrame() const { return lastFrame; }
+
+    /**
+     * @brief Get the collected frames, oldest first
+     */
+    [[nodiscard]] const std::deque<FrameStats>& GetHistory() const { return history; }
+
+    /**
+     * @brief Set how many frames GetHistory() keeps
+     */
+    void SetHistorySize(size_t frames);
+
+    /**
+     * @brief Stream every following frame to a trace file
+     * @param path Chrome trace-event JSON file to create
+     * @param frames Frames to capture, or 0 to capture until StopCapture()
+     * @return False if the file cannot be created
+     */
+    bool StartCapture(const std::string& path, std::uint32_t frames = 0);
+
+    /**
+     * @brief Finish the running capture and close its file
+     */
+    void StopCapture();
+
+    [[nodiscard]] bool IsCapturing() const { return capture.IsOpen(); }
+
+    /**
+     * @brief Write frames slower than a threshold to their own trace files
+     *
+     * Only the last few frames are kept in memory; when a frame exceeds the
+     * threshold they are written with it to "<pathPrefix>_frame<N>.json".
+     * @param thresholdMs Frame time that triggers a capture, or 0 to disable
+     * @param pathPrefix Path prefix of the written files
+     * @param framesBefore Frames preceding the spike to include
+     */
+    void SetSpikeCapture(double thresholdMs, const std::string& pathPrefix, std::uint32_t framesBefore = 2);
+
+    /**
+     * @brief Discard recorded zones and collected frames
+     */
+    void Reset();
+
+    [[nodiscard]] double TicksToMs(std::uint64_t ticks) const { return ticks / ticksPerMs; }
+
+private:
+    friend class ProfileZone;
+
+    static constexpr std::uint32_t kBufferCapacity = 4096;  // Power of two
+
+    static constexpr std::uint32_t kCounterDepth = 0xFFFFFFFFu;  // Marks counter samples
+
+    struct ZoneRecord {
+        const char* name;
+        std::uint64_t start;
+        union {
+            std::uint64_t end;
+            double value;                      ///< Counter samples only
+        };
+        std::uint32_t depth;                   ///< Nesting depth, or kCounterDepth
+    };
+
+    /**
+     * @brief Raw records of one frame, kept for trace captures
+     */
+    struct CapturedFrame {
+        std::uint64_t frame;
+        std::uint64_t start;
+        std::uint64_t end;
+        std::vector<std::pair<std::uint32_t, ZoneRecord>> records;  ///< Thread index and record
+    };
+
+    /**
+     * @brief Single-producer single-consumer ring of finished zones
+     * The owning thread pushes; EndFrame() drains.
+     */
+    struct ThreadBuffer {
+        ZoneRecord records[kBufferCapacity];
+        std::atomic<std::uint32_t> head{0};    ///< Next slot to write, owned by the producer
+        std::atomic<std::uint32_t> tail{0};    ///< Next slot to read, owned by the consumer
+        std::atomic<std::uint32_t> dropped{0};
+        std::uint32_t depth = 0;               ///< Open zones, producer only
+        std::uint32_t index = 0;
+        const char* name = nullptr;            ///< Guarded by buffersMutex
+
+        void Push(const ZoneRecord& record) {
+            const std::uint32_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == kBufferCapacity) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            records[h & (kBufferCapacity - 1)] = record;
+            head.store(h + 1, std::memory_order_release);
+        }
+    };
+
+    Profiler();
+
+    /**
+     * @brief Get the calling thread's buffer, registering it on first use
+     */
+    ThreadBuffer* GetThreadBuffer();
+
+    /**
+     * @brief Merge one thread's records into the frame's zone tree
+     */
+    void AddThreadZones(std::uint32_t thread, std::vector<ZoneRecord>& records, FrameStats& frame) const;
+
+    /**
+     * @brief Write a frame's records to a trace
+     */
+    void WriteFrame(TraceWriter& writer, const CapturedFrame& frame) const;
+
+    /**
+     * @brief Stream a frame to the running capture and check it for a spike
+     */
+    void CaptureFrame(CapturedFrame&& frame, double durationMs);
+
+    [[nodiscard]] double TicksToUs(std::uint64_t ticks) const { return (ticks - baseTicks) * 1000.0 / ticksPerMs; }
+
+    std::atomic<bool> enabled{true};
+
+    mutable std::mutex buffersMutex;  ///< Guards buffers and their names; never taken by zones
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    // Timestamp counter calibration against the steady clock
+    std::uint64_t baseTicks;
+    std::chrono::steady_clock::time_point baseTime;
+    double ticksPerMs = 1.0e6;
+
+    std::uint64_t frameStartTicks;
+    std::uint64_t frameCount = 0;
+    FrameStats lastFrame;
+    std::deque<FrameStats> history;
+    size_t historySize = 120;
+    std::vector<ZoneRecord> scratch;  ///< Drained records, reused between frames
+    std::vector<const char*> threadNames;  ///< Snapshot taken in EndFrame(), for captures
+
+    // Trace captures
+    TraceWriter capture;
+    std::uint32_t captureFramesLeft = 0;     ///< 0 when capturing until StopCapture()
+    double spikeThresholdMs = 0.0;
+    std::string spikePathPrefix;
+    std::uint32_t spikeFramesBefore = 0;
+    std::deque<CapturedFrame> recentFrames;  ///< Candidates to precede a spike
+};
+
+/**
+ * @brief Records the time from its construction to its destruction as a zone
+ */
+class ProfileZone {
+public:
+    /**
+     * @param name Zone name; must outlive the profiler, e.g. a literal
+     */
+    explicit ProfileZone(const char* name) : name(name) {
+        Profiler& profiler = Profiler::Instance();
+        if (!profiler.IsEnabled()) return;
+
+        buffer = profiler.GetThreadBuffer();
+        depth = buffer->depth++;
+        start = Profiler::ReadTicks();
+    }
+
+    ~ProfileZone() {
+        if (!buffer) return;
+
+        const std::uint64_t end = Profiler::ReadTicks();
+        --buffer->depth;
+        buffer->Push({name, start, end, depth});
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    Profiler::ThreadBuffer* buffer = nullptr;
+    std::uint64_t start = 0;
+    std::uint32_t depth = 0;
+};
+
+#define GAMEFRAMEWORK_PROFILE_CONCAT_(a, b) a##b
+#define GAMEFRAMEWORK_PROFILE_CONCAT(a, b) GAMEFRAMEWORK_PROFILE_CONCAT_(a, b)
+
+#ifdef GAMEFRAMEWORK_PROFILER
+#define PROFILE_ZONE(name) ProfileZone GAMEFRAMEWORK_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_FRAME() Profiler::Instance().EndFrame()
+#define PROFILE_THREAD(name) Profiler::Instance().SetThreadName(name)
+#define PROFILE_COUNTER(name, value) Profiler::Instance().RecordCounter(name, value)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#endif
@@ -0,0 +1,144 @@
+#include "statsoverlay.h"
+#include <cstdio>
+
+namespace {
+    double GaugeValue(const char* name) {
+        const Metrics::Gauge* gauge = Metrics::Instance().FindGauge(name);
+        return gauge ? gauge->Get() : 0.0;
+    }
+
+    unsigned long long CounterFrameValue(const char* name) {
+        const Metrics::Counter* counter = Metrics::Instance().FindCounter(name);
+        return counter ? static_cast<unsigned long long>(counter->GetFrameValue()) : 0;
+    }
+}
+
+StatsOverlay::StatsOverlay() {
+    position = Vector2D(8, 8);
+    size = Vector2D(320, 0);
+}
+
+StatsOverlay::~StatsOverlay() {
+    DestroyTextures();
+    if (font) {
+        TTF_CloseFont(font);
+    }
+}
+
+void StatsOverlay::SetFont(const std::string& path, int pointSize) {
+    DestroyTextures();
+    if (font) {
+        TTF_CloseFont(font);
+        font = nullptr;
+    }
+    fontPath = path;
+    fontSize = pointSize;
+    fontFailed = false;
+}
+
+void StatsOverlay::DestroyTextures() {
+    for (auto& line : lineTextures) {
+        if (line.texture) {
+            SDL_DestroyTexture(line.texture);
+        }
+    }
+    lineTextures.clear();
+}
+
+void StatsOverlay::Refresh() {
+    const Metrics::Histogram* frameTime = Metrics::Instance().FindHistogram("frame.time_ms");
+    Metrics::Histogram::Snapshot frames;
+    if (frameTime) {
+        const Metrics::Histogram::Snapshot now = frameTime->GetSnapshot();
+        frames = now.Since(lastFrameTimes);
+        lastFrameTimes = now;
+    }
+
+    char line[128];
+    lineText.clear();
+    std::snprintf(line, sizeof(line), "FPS %.0f  frame %.2f ms", GaugeValue("frame.fps"), frames.Mean());
+    lineText.emplace_back(line);
+    std::snprintf(line, sizeof(line), "frame ms p50 %.1f  p95 %.1f  p99 %.1f",
+                  frames.Percentile(50.0), frames.Percentile(95.0), frames.Percentile(99.0));
+    lineText.emplace_back(line);
+    std::snprintf(line, sizeof(line), "objects %.0f  updated %.0f  collisions %.0f",
+                  GaugeValue("scene.objects"), GaugeValue("scene.objects_updated"), GaugeValue("scene.collisions"));
+    lineText.emplace_back(line);
+    std::snprintf(line, sizeof(line), "draw calls %llu  collision pairs %llu",
+                  CounterFrameValue("render.draw_calls"), CounterFrameValue("scene.collision_pairs"));
+    lineText.emplace_back(line);
+    std::snprintf(line, sizeof(line), "textures %.0f  %.1f MB  hit %.0f%%", GaugeValue("assets.textures.count"),
+                  GaugeValue("assets.textures.bytes") / (1024.0 * 1024.0),
+                  GaugeValue("assets.textures.hit_rate") * 100.0);
+    lineText.emplace_back(line);
+    std::snprintf(line, sizeof(line), "sounds %.0f  playing %.0f  pending loads %.0f",
+                  GaugeValue("assets.sounds.count"), GaugeValue("audio.channels_playing"),
+                  GaugeValue("assets.pending_loads"));
+    lineText.emplace_back(line);
+
+    size.y = static_cast<float>(lineText.size() * kLineHeight);
+}
+
+void StatsOverlay::Update(float deltaTime) {
+    if (!active) return;
+
+    sinceRefresh += deltaTime;
+    if (lineText.empty() || sinceRefresh >= refreshInterval) {
+        sinceRefresh = 0.0f;
+        Refresh();
+    }
+    UIElement::Update(deltaTime);
+}
+
+void StatsOverlay::Render(SDL_Renderer* renderer) {
+    if (!visible) return;
+
+    // Dark backing keeps the text readable over any scene
+    SDL_Rect background = GetBounds();
+    background.x -= 4;
+    background.y -= 4;
+    background.w += 8;
+    background.h += 8;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &background);
+
+    if (!font && !fontFailed) {
+        font = TTF_OpenFont(fontPath.c_str(), fontSize);
+        if (!font) {
+            fontFailed = true;
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Stats overlay font '%s' failed to open: %s",
+                         fontPath.c_str(), TTF_GetError());
+        }
+    }
+    if (font) {
+        if (lineTextures.size() < lineText.size()) {
+            lineTextures.resize(lineText.size());
+        }
+        const SDL_Rect bounds = GetBounds();
+        for (size_t i = 0; i < lineText.size(); ++i) {
+            LineTexture& line = lineTextures[i];
+            if (!line.texture || line.text != lineText[i]) {
+                if (line.texture) {
+                    SDL_DestroyTexture(line.texture);
+                    line.texture = nullptr;
+                }
+                line.text = lineText[i];
+
+                SDL_Surface* surface = TTF_RenderText_Blended(font, line.text.c_str(), {255, 255, 255, 255});
+                if (!surface) continue;
+                line.texture = SDL_CreateTextureFromSurface(renderer, surface);
+                line.width = surface->w;
+                line.height = surface->h;
+                SDL_FreeSurface(surface);
+            }
+            if (!line.texture) continue;
+
+            const int top = bounds.y + static_cast<int>(i) * kLineHeight;
+            SDL_Rect dest = {bounds.x, top + (kLineHeight - line.height) / 2, line.width, line.height};
+            SDL_RenderCopy(renderer, line.texture, nullptr, &dest);
+        }
+    }
+
+    UIElement::Render(renderer);
+}
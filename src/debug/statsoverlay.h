@@ -0,0 +1,84 @@
+/**
+ * @file statsoverlay.h
+ * @brief On-screen display of the framework's runtime metrics
+ *
+ * Shows frame rate, frame time percentiles, object and collision counts,
+ * draw calls, asset cache use and audio channels from the Metrics registry.
+ * The text is rebuilt at the refresh interval rather than every frame, and
+ * percentiles cover the frames since the previous refresh.
+ * Enable it with Game::SetStatsOverlayEnabled().
+ *
+ * The overlay owns its font, opened on the first render, and keeps one
+ * texture per line that is redrawn only when the line's text changes.
+ */
+#pragma once
+#include "metrics.h"
+#include "../ui/ui_element.h"
+#include <string>
+#include <vector>
+
+class StatsOverlay : public UIElement {
+public:
+    static constexpr const char* kDefaultFontPath = "assets/fonts/default.ttf";
+    static constexpr int kDefaultFontSize = 14;
+
+    StatsOverlay();
+    ~StatsOverlay() override;
+
+    // Owns the font and line textures
+    StatsOverlay(const StatsOverlay&) = delete;
+    StatsOverlay& operator=(const StatsOverlay&) = delete;
+
+    /**
+     * @brief Choose the font the text is drawn with
+     * The font is opened on the next render; SDL_ttf must be initialized.
+     * @param path TrueType font file
+     * @param pointSize Font size in points
+     */
+    void SetFont(const std::string& path, int pointSize = kDefaultFontSize);
+    [[nodiscard]] const std::string& GetFontPath() const { return fontPath; }
+
+    /**
+     * @brief Set how often the text is rebuilt
+     * @param seconds Time between refreshes
+     */
+    void SetRefreshInterval(float seconds) { refreshInterval = seconds; }
+    [[nodiscard]] float GetRefreshInterval() const { return refreshInterval; }
+
+    /**
+     * @brief Rebuild the text from the current metrics
+     */
+    void Refresh();
+
+    /**
+     * @brief Text of each line as of the last refresh
+     */
+    [[nodiscard]] const std::vector<std::string>& GetLines() const { return lineText; }
+
+    void Update(float deltaTime) override;
+    void Render(SDL_Renderer* renderer) override;
+
+private:
+    static constexpr int kLineHeight = 18;
+
+    // Rendered text of one line
+    struct LineTexture {
+        std::string text;
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+
+    void DestroyTextures();
+
+    float refreshInterval = 0.5f;
+    float sinceRefresh = 0.0f;
+    Metrics::Histogram::Snapshot lastFrameTimes;  ///< Frame times as of the previous refresh
+    std::vector<std::string> lineText;
+    std::vector<LineTexture> lineTextures;
+
+    std::string fontPath = kDefaultFontPath;
+    int fontSize = kDefaultFontSize;
+    TTF_Font* font = nullptr;
+    bool fontFailed = false;  ///< Opening fontPath failed; not retried until SetFont()
+};
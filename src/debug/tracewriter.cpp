@@ -0,0 +1,97 @@
+#include "tracewriter.h"
+#include <cmath>
+#include <cstdio>
+
+bool TraceWriter::Open(const std::string& path) {
+    Close();
+
+    out.open(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    firstEvent = true;
+    threadNames.clear();
+    return true;
+}
+
+void TraceWriter::Close() {
+    if (!out.is_open()) return;
+
+    out << "\n]}\n";
+    out.close();
+}
+
+void TraceWriter::BeginEvent() {
+    out << (firstEvent ? "\n" : ",\n");
+    firstEvent = false;
+}
+
+void TraceWriter::WriteString(const char* text) {
+    out << '"';
+    for (const char* c = text ? text : ""; *c; ++c) {
+        switch (*c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                    out << escaped;
+                } else {
+                    out << *c;
+                }
+        }
+    }
+    out << '"';
+}
+
+void TraceWriter::WriteThreadName(std::uint32_t thread, const char* name) {
+    if (!out.is_open() || !name) return;
+    if (threadNames.size() <= thread) {
+        threadNames.resize(thread + 1, nullptr);
+    }
+    if (threadNames[thread] == name) return;
+    threadNames[thread] = name;
+
+    BeginEvent();
+    out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+    WriteString(name);
+    out << "}}";
+}
+
+void TraceWriter::WriteZone(std::uint32_t thread, const char* name, double startUs, double durationUs) {
+    if (!out.is_open()) return;
+
+    char times[64];
+    std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", startUs, durationUs);
+
+    BeginEvent();
+    out << "{\"ph\":\"X\",\"name\":";
+    WriteString(name);
+    out << ",\"pid\":1,\"tid\":" << thread << ',' << times << '}';
+}
+
+void TraceWriter::WriteCounter(const char* name, double timeUs, double value) {
+    if (!out.is_open()) return;
+
+    char fields[96];
+    std::snprintf(fields, sizeof(fields), "\"ts\":%.3f,\"args\":{\"value\":%.17g}", timeUs,
+                  std::isfinite(value) ? value : 0.0);
+
+    BeginEvent();
+    out << "{\"ph\":\"C\",\"name\":";
+    WriteString(name);
+    out << ",\"pid\":1," << fields << '}';
+}
+
+void TraceWriter::WriteFrameMarker(std::uint64_t frame, double timeUs) {
+    if (!out.is_open()) return;
+
+    char fields[96];
+    std::snprintf(fields, sizeof(fields), "\"ts\":%.3f,\"args\":{\"frame\":%llu}", timeUs,
+                  static_cast<unsigned long long>(frame));
+
+    BeginEvent();
+    out << "{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame\",\"pid\":1,\"tid\":0," << fields << '}';
+}
@@ -0,0 +1,71 @@
+/**
+ * @file tracewriter.h
+ * @brief Streaming writer for Chrome trace-event JSON files
+ *
+ * Events are formatted and written as they arrive, so a capture of any
+ * length needs no more memory than one output buffer. The files open in
+ * chrome://tracing and in the Perfetto UI.
+ */
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class TraceWriter {
+public:
+    TraceWriter() = default;
+    ~TraceWriter() { Close(); }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief Create a trace file, closing any open one
+     * @return False if the file cannot be created
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Terminate the event array and close the file
+     */
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return out.is_open(); }
+
+    /**
+     * @brief Label a thread's track
+     * Writes nothing if the thread already has this name in the file.
+     */
+    void WriteThreadName(std::uint32_t thread, const char* name);
+
+    /**
+     * @brief Write a zone as a complete ("X") event
+     * @param startUs Start time in microseconds
+     * @param durationUs Duration in microseconds
+     */
+    void WriteZone(std::uint32_t thread, const char* name, double startUs, double durationUs);
+
+    /**
+     * @brief Write a counter ("C") sample
+     * Non-finite values are written as 0, which JSON can represent.
+     */
+    void WriteCounter(const char* name, double timeUs, double value);
+
+    /**
+     * @brief Mark the start of a frame with a global instant event
+     */
+    void WriteFrameMarker(std::uint64_t frame, double timeUs);
+
+private:
+    /**
+     * @brief Start the next event, separating it from the previous one
+     */
+    void BeginEvent();
+
+    void WriteString(const char* text);
+
+    std::ofstream out;
+    bool firstEvent = true;
+    std::vector<const char*> threadNames;  ///< Name written per thread
+};
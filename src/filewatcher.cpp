@@ -0,0 +1,229 @@
+#include "filewatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    fs::file_time_type GetModifiedTime(const std::string& path) {
+        std::error_code error;
+        auto modified = fs::last_write_time(path, error);
+        return error ? fs::file_time_type::min() : modified;
+    }
+}
+
+FileWatcher::FileWatcher(Callback onChange, int pollIntervalMs)
+    : onChange(std::move(onChange))
+    , pollIntervalMs(pollIntervalMs)
+{
+#ifdef __linux__
+    notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd >= 0 && pipe2(wakeFds, O_CLOEXEC) != 0) {
+        close(notifyFd);
+        notifyFd = -1;
+    }
+#endif
+
+    thread = std::thread(&FileWatcher::Run, this);
+}
+
+FileWatcher::~FileWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+#ifdef __linux__
+    if (wakeFds[1] >= 0) {
+        const char wake = 1;
+        (void)write(wakeFds[1], &wake, 1);
+    }
+#endif
+
+    thread.join();
+
+#ifdef __linux__
+    if (notifyFd >= 0) close(notifyFd);
+    if (wakeFds[0] >= 0) close(wakeFds[0]);
+    if (wakeFds[1] >= 0) close(wakeFds[1]);
+#endif
+}
+
+void FileWatcher::Watch(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (files.count(path)) return;
+
+    WatchedFile file;
+    file.modified = GetModifiedTime(path);
+
+#ifdef __linux__
+    if (notifyFd >= 0) {
+        // Watch the directory so files replaced by rename are still seen
+        std::string directory = fs::path(path).parent_path().string();
+        if (directory.empty()) directory = ".";
+
+        // Adding the same directory again returns its existing watch
+        file.directoryWatch = inotify_add_watch(notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    }
+#endif
+
+    files.emplace(path, file);
+
+#ifdef __linux__
+    // The directory could not be watched (missing, no permission, watch limit
+    // reached), so wake the notification loop to start polling this file
+    if (notifyFd >= 0 && file.directoryWatch < 0) {
+        const char wake = 1;
+        (void)write(wakeFds[1], &wake, 1);
+    }
+#endif
+}
+
+void FileWatcher::Unwatch(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = files.find(path);
+    if (it == files.end()) return;
+
+    const int directoryWatch = it->second.directoryWatch;
+    files.erase(it);
+
+#ifdef __linux__
+    if (directoryWatch >= 0) {
+        for (const auto& [other, file] : files) {
+            if (file.directoryWatch == directoryWatch) return;
+        }
+        inotify_rm_watch(notifyFd, directoryWatch);
+    }
+#endif
+}
+
+void FileWatcher::Run() {
+#ifdef __linux__
+    if (notifyFd >= 0) {
+        using Clock = std::chrono::steady_clock;
+        const auto interval = std::chrono::milliseconds(pollIntervalMs);
+        auto nextPoll = Clock::now() + interval;
+
+        for (;;) {
+            // Files without a directory watch are polled between notifications
+            bool polling = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopping) return;
+                for (const auto& [path, file] : files) {
+                    if (file.directoryWatch < 0) {
+                        polling = true;
+                        break;
+                    }
+                }
+            }
+
+            int timeout = -1;
+            if (polling) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(nextPoll - Clock::now());
+                timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+            }
+
+            pollfd fds[2] = {{notifyFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+            if (poll(fds, 2, timeout) < 0) continue;
+            if (fds[1].revents & POLLIN) {
+                char wake[16];
+                (void)read(wakeFds[0], wake, sizeof(wake));
+            }
+            if (fds[0].revents & POLLIN) ReadNotifications();
+
+            const auto now = Clock::now();
+            if (!polling) {
+                nextPoll = now + interval;
+            } else if (now >= nextPoll) {
+                PollOnce(true);
+                nextPoll = now + interval;
+            }
+        }
+    }
+#endif
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(pollIntervalMs));
+        if (stopping) break;
+
+        lock.unlock();
+        PollOnce(false);
+        lock.lock();
+    }
+}
+
+void FileWatcher::PollOnce(bool unwatchedOnly) {
+    std::vector<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [path, file] : files) {
+            if (unwatchedOnly && file.directoryWatch >= 0) continue;
+
+            auto modified = GetModifiedTime(path);
+            if (modified != file.modified) {
+                file.modified = modified;
+                changed.push_back(path);
+            }
+        }
+    }
+
+    // Callbacks run without the lock so they may call Watch() or Unwatch()
+    for (const auto& path : changed) {
+        onChange(path);
+    }
+}
+
+void FileWatcher::ReadNotifications() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    std::vector<std::string> changed;
+    bool overflowed = false;
+
+    for (;;) {
+        ssize_t length = read(notifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (char* p = buffer; p < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflowed = true;
+                continue;
+            }
+            if (event->len == 0) continue;
+
+            const std::string name = event->name;
+            for (auto& [path, file] : files) {
+                if (file.directoryWatch == event->wd && fs::path(path).filename() == name) {
+                    file.modified = GetModifiedTime(path);
+                    changed.push_back(path);
+                }
+            }
+        }
+    }
+
+    for (const auto& path : changed) {
+        onChange(path);
+    }
+
+    // Events were lost; fall back to comparing modification times
+    if (overflowed) {
+        PollOnce(false);
+    }
+#endif
+}
@@ -0,0 +1,80 @@
+/**
+ * @file filewatcher.h
+ * @brief Background watcher that reports modified files
+ *
+ * On Linux the watcher uses inotify on the directories containing the
+ * watched files, which also catches editors that save by writing a new file
+ * and renaming it over the old one. Elsewhere, or if inotify is unavailable,
+ * it falls back to polling modification times; files whose directory cannot
+ * be watched are polled alongside the notifications.
+ */
+#pragma once
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class FileWatcher {
+public:
+    // Called on the watcher thread with the path as passed to Watch()
+    using Callback = std::function<void(const std::string& path)>;
+
+    /**
+     * @brief Start watching on a background thread
+     * @param onChange Called whenever a watched file is written or replaced
+     * @param pollIntervalMs Interval between checks when polling
+     */
+    explicit FileWatcher(Callback onChange, int pollIntervalMs = 500);
+
+    /**
+     * @brief Stop the background thread
+     */
+    ~FileWatcher();
+
+    // Prevent copying and assignment
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Report changes to a file; watching a file twice has no effect
+     * @param path File to watch
+     */
+    void Watch(const std::string& path);
+
+    /**
+     * @brief Stop reporting changes to a file
+     * @param path File passed to Watch()
+     */
+    void Unwatch(const std::string& path);
+
+    /**
+     * @brief Check whether changes are detected with inotify rather than polling
+     */
+    [[nodiscard]] bool IsUsingNotifications() const { return notifyFd >= 0; }
+
+private:
+    void Run();
+    // Report files whose modification time changed, only those without an inotify watch if unwatchedOnly
+    void PollOnce(bool unwatchedOnly);
+    void ReadNotifications();
+
+    // Information about one watched file
+    struct WatchedFile {
+        std::filesystem::file_time_type modified;
+        int directoryWatch = -1;  ///< inotify watch of the containing directory
+    };
+
+    Callback onChange;
+    int pollIntervalMs;
+    int notifyFd = -1;
+    int wakeFds[2] = {-1, -1};   ///< Pipe used to interrupt the notification wait
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    bool stopping = false;
+    std::unordered_map<std::string, WatchedFile> files;
+    std::thread thread;
+};
@@ -1,14 +1,32 @@
 #include "game.h"
+#include <asset-manager.h>
+#include <audiomanager.h>
+#include <debug/metrics.h>
+#include <debug/profiler.h>
 #include <keyboard.h>
 #include <mouse.h>
 #include <random>
 
 #include <SDL_image.h>
 #include <SDL_mixer.h>
+#include <SDL_ttf.h>
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
 Game::~Game() {
+    // Everything holding textures or a font must go before SDL_ttf and the
+    // renderer; members are only destroyed after this body runs
+    currentScene.reset();
+    preloadingScene.reset();
+    scenePreload = AssetManager::ManifestLoad();
+    postProcess = PostProcessChain();
+    sceneTarget.reset();
+    statsOverlay.reset();
+    if (ttfInitialized) {
+        TTF_Quit();
+    }
+
     if (renderer) {
         SDL_DestroyRenderer(renderer);
     }
@@ -73,10 +91,15 @@ bool Game::Initialize(const std::string& windowTitle, int windowWidth, int windo
 
 void Game::Run() {
     while (isRunning) {
-        ProcessInput();
-        Update();
-        Render();
+        {
+            PROFILE_ZONE("Game::Run");
+            ProcessInput();
+            Update();
+            Render();
+        }
+        PROFILE_FRAME();
         CalculateDeltaTime();
+        PublishMetrics();
 
         // Frame rate limiting
         int frameTime = SDL_GetTicks() - lastFrameTime;
@@ -95,8 +118,21 @@ void Game::ChangeScene(std::shared_ptr<Scene> newScene) {
         currentScene->OnExit();
     }
 
+    // Drops the old scene, and with it the references to its assets
     currentScene = std::move(newScene);
 
+    if (currentScene && !currentScene->GetAssetManifest().IsEmpty()) {
+        const AssetManifest& manifest = currentScene->GetAssetManifest();
+        AssetManager::Instance().LoadManifest(manifest);
+        // Sounds still playing keep their chunks alive
+        AudioManager::Instance().ReleaseFinishedChannels();
+        AssetManager::Instance().ReleaseUnused(manifest);
+    }
+    if (preloadingScene == currentScene) {
+        preloadingScene = nullptr;
+        scenePreload = AssetManager::ManifestLoad();
+    }
+
     // Initialize the new scene
     if (currentScene) {
         // Add this line to call OnEnter for the new scene
@@ -104,7 +140,18 @@ void Game::ChangeScene(std::shared_ptr<Scene> newScene) {
     }
 }
 
+void Game::PreloadScene(std::shared_ptr<Scene> scene) {
+    scenePreload = scene ? AssetManager::Instance().PreloadManifest(scene->GetAssetManifest())
+                         : AssetManager::ManifestLoad();
+    preloadingScene = std::move(scene);
+}
+
+bool Game::IsScenePreloaded(const std::shared_ptr<Scene>& scene) const {
+    return scene && scene == preloadingScene && scenePreload.IsDone();
+}
+
 void Game::ProcessInput() {
+    PROFILE_ZONE("Game::ProcessInput");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
@@ -118,19 +165,71 @@ void Game::ProcessInput() {
 }
 
 void Game::Update() {
+    PROFILE_ZONE("Game::Update");
+    // Deliver finished background loads before the scene looks at them
+    AssetManager::Instance().ProcessPendingUploads(assetUploadBudgetMs);
+    AudioManager::Instance().ReleaseFinishedChannels();
+
     if (currentScene) {
         currentScene->Update(deltaTime);
     }
+
+    if (statsOverlay) {
+        statsOverlay->Update(deltaTime);
+    }
+}
+
+void Game::SetInternalResolution(int internalWidth, int internalHeight) {
+    this->internalWidth = std::max(internalWidth, 0);
+    this->internalHeight = std::max(internalHeight, 0);
 }
 
 void Game::Render() {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    PROFILE_ZONE("Game::Render");
+    bool offscreen = internalWidth > 0 || postProcess.HasActiveEffects();
+
+    if (offscreen) {
+        try {
+            if (!sceneTarget) {
+                sceneTarget = std::make_unique<RenderTarget>(GetRenderWidth(), GetRenderHeight());
+            } else {
+                sceneTarget->Resize(GetRenderWidth(), GetRenderHeight());
+            }
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+                "Offscreen rendering unavailable, disabling scaling and post-processing: %s", e.what());
+            internalWidth = 0;
+            internalHeight = 0;
+            postProcess.ClearEffects();
+            offscreen = false;
+        }
+    }
+
+    if (!offscreen) {
+        sceneTarget.reset();
+    } else {
+        sceneTarget->Begin();
+    }
+
+    // A retained scene overwrites the whole frame with its cached copy
+    if (!currentScene || !currentScene->IsRetainedRenderingEnabled()) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+    }
 
     if (currentScene) {
         currentScene->Render();
     }
 
+    if (offscreen) {
+        sceneTarget->End();
+        postProcess.Present(*sceneTarget);
+    }
+
+    if (statsOverlay) {
+        statsOverlay->Render(renderer);
+    }
+
     SDL_RenderPresent(renderer);
 }
 
@@ -138,4 +237,41 @@ void Game::CalculateDeltaTime() {
     Uint32 currentTime = SDL_GetTicks();
     deltaTime = (currentTime - lastFrameTime) / 1000.0f;
     lastFrameTime = currentTime;
+}
+
+void Game::PublishMetrics() {
+    Metrics& metrics = Metrics::Instance();
+    static Metrics::Histogram& frameTime = metrics.GetHistogram("frame.time_ms");
+    static Metrics::Gauge& fps = metrics.GetGauge("frame.fps");
+    static Metrics::Gauge& channelsPlaying = metrics.GetGauge("audio.channels_playing");
+
+    // Finer than deltaTime, which has millisecond resolution
+    const Uint64 now = SDL_GetPerformanceCounter();
+    if (lastMetricsTime != 0) {
+        const double frameMs = static_cast<double>(now - lastMetricsTime) * 1000.0 / SDL_GetPerformanceFrequency();
+        frameTime.Record(frameMs);
+        fps.Set(frameMs > 0.0 ? 1000.0 / frameMs : 0.0);
+    }
+    lastMetricsTime = now;
+
+    AssetManager::Instance().PublishMetrics();
+    channelsPlaying.Set(Mix_Playing(-1));
+    metrics.EndFrame();
+}
+
+void Game::SetStatsOverlayEnabled(bool enabled) {
+    if (!enabled) {
+        statsOverlay.reset();
+        return;
+    }
+    if (statsOverlay) return;
+
+    if (!ttfInitialized) {
+        if (TTF_Init() != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Stats overlay disabled, SDL_ttf failed: %s", TTF_GetError());
+            return;
+        }
+        ttfInitialized = true;
+    }
+    statsOverlay = std::make_unique<StatsOverlay>();
 }
\ No newline at end of file
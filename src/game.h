@@ -8,10 +8,15 @@
  */
 #pragma once
 #include <SDL2/SDL.h>
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <string>
 #include "scene.h"
+#include "asset-manager.h"
+#include "postprocess.h"
+#include "rendertarget.h"
+#include "debug/statsoverlay.h"
 
 class Game {
 public:
@@ -69,12 +74,52 @@ public:
      */
     [[nodiscard]] int GetWindowHeight() const { return height; }
 
+    /**
+     * @brief Render scenes at a fixed internal resolution and upscale to the window
+     *
+     * Rendering fewer pixels is the main lever for performance on weak
+     * hardware. Pass 0 for both dimensions to render at window resolution.
+     * @param internalWidth Internal render width in pixels
+     * @param internalHeight Internal render height in pixels
+     */
+    void SetInternalResolution(int internalWidth, int internalHeight);
+
+    /**
+     * @brief Get the width scenes are rendered at
+     * @return Internal resolution width, or the window width if none is set
+     */
+    [[nodiscard]] int GetRenderWidth() const { return internalWidth > 0 ? internalWidth : width; }
+
+    /**
+     * @brief Get the height scenes are rendered at
+     * @return Internal resolution height, or the window height if none is set
+     */
+    [[nodiscard]] int GetRenderHeight() const { return internalHeight > 0 ? internalHeight : height; }
+
+    /**
+     * @brief Get the post-processing chain applied to every frame
+     * @return Reference to the post-process chain
+     */
+    PostProcessChain& GetPostProcessChain() { return postProcess; }
+
     /**
      * @brief Get the time elapsed since last frame
      * @return Delta time in seconds
      */
     [[nodiscard]] float GetDeltaTime() const { return deltaTime; }
 
+    /**
+     * @brief Limit how long asynchronous asset loads may spend finishing each frame
+     * @param milliseconds Per-frame budget for texture uploads and load callbacks
+     */
+    void SetAssetUploadBudget(float milliseconds) { assetUploadBudgetMs = std::max(milliseconds, 0.0f); }
+
+    /**
+     * @brief Get the per-frame budget for finishing asynchronous asset loads
+     * @return Budget in milliseconds
+     */
+    [[nodiscard]] float GetAssetUploadBudget() const { return assetUploadBudgetMs; }
+
     /**
      * @brief Check if the game is currently running
      * @return true if the game loop is active
@@ -87,6 +132,40 @@ public:
      */
     void ChangeScene(std::shared_ptr<Scene> newScene);
 
+    /**
+     * @brief Start loading a scene's manifest in the background
+     *
+     * Call while the current scene runs; once IsScenePreloaded() returns
+     * true, ChangeScene() to that scene does not load anything. Changing to
+     * a scene whose preload is unfinished loads the rest synchronously.
+     * @param scene Scene that will be switched to next
+     */
+    void PreloadScene(std::shared_ptr<Scene> scene);
+
+    /**
+     * @brief Check whether every asset of the preloaded scene is loaded
+     * @param scene Scene passed to PreloadScene()
+     */
+    [[nodiscard]] bool IsScenePreloaded(const std::shared_ptr<Scene>& scene) const;
+
+    /**
+     * @brief Show or hide the runtime stats overlay
+     * The overlay is drawn over the final frame at window resolution.
+     * Metrics are collected whether or not it is shown. Enabling it
+     * initializes SDL_ttf and fails, leaving it disabled, if that fails.
+     * Use GetStatsOverlay()->SetFont() to draw with another font.
+     * @param enabled True to show the overlay
+     */
+    void SetStatsOverlayEnabled(bool enabled);
+
+    [[nodiscard]] bool IsStatsOverlayEnabled() const { return statsOverlay != nullptr; }
+
+    /**
+     * @brief Get the stats overlay to reposition or configure it
+     * @return The overlay, or nullptr if it is disabled
+     */
+    StatsOverlay* GetStatsOverlay() const { return statsOverlay.get(); }
+
 private:
     // Private constructor for singleton
     Game()
@@ -100,6 +179,8 @@ private:
         , deltaTime(0.0f)
         , targetFrameRate(60.0f)
         , frameDelay(1000.0f / 60.0f)
+        , internalWidth(0)
+        , internalHeight(0)
     {}
 
     ~Game();
@@ -124,6 +205,11 @@ private:
      */
     void CalculateDeltaTime();
 
+    /**
+     * @brief Record frame metrics and close the frame in the Metrics registry
+     */
+    void PublishMetrics();
+
     std::string title;    ///< Window title
     int width;           ///< Window width
     int height;          ///< Window height
@@ -132,9 +218,20 @@ private:
     SDL_Window* window;      ///< SDL window handle
     SDL_Renderer* renderer;  ///< SDL renderer handle
     std::shared_ptr<Scene> currentScene;  ///< Currently active scene
+    std::shared_ptr<Scene> preloadingScene;  ///< Scene whose assets are loading in the background
+    AssetManager::ManifestLoad scenePreload;  ///< Keeps the preloaded assets alive until the switch
 
     Uint32 lastFrameTime;   ///< Timestamp of last frame
     float deltaTime;        ///< Time elapsed since last frame
     float targetFrameRate;  ///< Target frame rate (default: 60 FPS)
     float frameDelay;       ///< Delay between frames
+
+    int internalWidth;      ///< Internal render width (0 = window width)
+    int internalHeight;     ///< Internal render height (0 = window height)
+    std::unique_ptr<RenderTarget> sceneTarget;  ///< Offscreen frame used for scaling and post-processing
+    PostProcessChain postProcess;               ///< Effects applied when presenting the frame
+    float assetUploadBudgetMs = 4.0f;           ///< Per-frame time for finishing async asset loads
+    std::unique_ptr<StatsOverlay> statsOverlay; ///< Shown when enabled
+    bool ttfInitialized = false;                ///< TTF_Init() was called for the overlay
+    Uint64 lastMetricsTime = 0;                 ///< Performance counter at the previous PublishMetrics()
 };
\ No newline at end of file
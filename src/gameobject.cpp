@@ -1,6 +1,7 @@
 #include "gameobject.h"
 
 #include <game.h>
+#include <algorithm>
 #include <utility>
 
 GameObject::GameObject(std::string  tag)
@@ -9,6 +10,25 @@ GameObject::GameObject(std::string  tag)
 {
 }
 
+GameObject::~GameObject() {
+    for (GameObject* child : children) {
+        Transform world = child->GetWorldTransform();
+        child->parent = nullptr;
+        child->transform = world;
+        child->worldValid = false;
+        child->UpdateHierarchyDepth();
+    }
+
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+
+    if (parent || !children.empty()) {
+        ++hierarchyGeneration;
+    }
+}
+
 void GameObject::Update(float deltaTime) {
     // Base class doesn't implement any behavior
 }
@@ -16,16 +36,108 @@ void GameObject::Update(float deltaTime) {
 void GameObject::Render() {
     if (!isActive || !sprite) return;
 
-    sprite->Render(transform);
+    const Transform& world = GetWorldTransform();
+    sprite->Render(world);
 
     // Debug render for collider if it exists
 #ifdef _DEBUG
     if (collider) {
-        collider->RenderDebug(renderer, transform);
+        collider->RenderDebug(renderer, world);
     }
 #endif
 }
 
+bool GameObject::GetRenderBounds(SDL_Rect& bounds) const {
+    const Transform& world = GetWorldTransform();
+    if (sprite) {
+        bounds = sprite->GetBounds(world);
+    } else {
+        bounds = {static_cast<int>(world.position.x), static_cast<int>(world.position.y), 0, 0};
+    }
+    return true;
+}
+
+bool GameObject::SetParent(GameObject* newParent, bool keepWorldTransform) {
+    if (newParent == parent) return true;
+
+    for (GameObject* ancestor = newParent; ancestor; ancestor = ancestor->parent) {
+        if (ancestor == this) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "Cannot parent '%s' to itself or one of its descendants", tag.c_str());
+            return false;
+        }
+    }
+
+    Matrix2D world = GetWorldMatrix();
+
+    if (parent) {
+        auto& siblings = parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+
+    parent = newParent;
+    if (parent) {
+        parent->children.push_back(this);
+    }
+
+    if (keepWorldTransform) {
+        transform = Transform::FromMatrix(parent ? parent->GetWorldMatrix().Inverse() * world : world);
+    }
+
+    worldValid = false;
+    UpdateHierarchyDepth();
+    ++hierarchyGeneration;
+    return true;
+}
+
+const Matrix2D& GameObject::GetWorldMatrix() const {
+    UpdateWorldMatrix();
+    return worldMatrix;
+}
+
+const Transform& GameObject::GetWorldTransform() const {
+    if (!parent) return transform;
+
+    UpdateWorldMatrix();
+    return worldTransform;
+}
+
+void GameObject::UpdateWorldMatrix() const {
+    // Ancestors are refreshed top-down so each level only compares versions
+    // unless something above it actually moved
+    if (parent) {
+        parent->UpdateWorldMatrix();
+    }
+    RefreshWorldMatrix();
+}
+
+void GameObject::RefreshWorldMatrix() const {
+    unsigned int localVersion = transform.GetMatrixVersion();
+    unsigned int parentVersion = parent ? parent->worldVersion : 0;
+    if (worldValid && localVersion == localVersionSeen && parentVersion == parentVersionSeen) {
+        return;
+    }
+
+    if (parent) {
+        worldMatrix = parent->worldMatrix * transform.GetMatrix();
+        worldTransform = Transform::FromMatrix(worldMatrix);
+    } else {
+        worldMatrix = transform.GetMatrix();
+    }
+
+    localVersionSeen = localVersion;
+    parentVersionSeen = parentVersion;
+    worldValid = true;
+    ++worldVersion;
+}
+
+void GameObject::UpdateHierarchyDepth() {
+    hierarchyDepth = parent ? parent->hierarchyDepth + 1 : 0;
+    for (GameObject* child : children) {
+        child->UpdateHierarchyDepth();
+    }
+}
+
 void GameObject::SetSprite(std::shared_ptr<Sprite> sprite) {
     this->sprite = std::move(sprite);
 }
@@ -38,5 +150,5 @@ bool GameObject::CheckCollision(const GameObject& other) const {
     if (!isActive || !other.IsActive()) return false;
     if (!collider || !other.collider) return false;
 
-    return collider->CheckCollision(*other.collider, transform, other.GetTransform());
+    return collider->CheckCollision(*other.collider, GetWorldTransform(), other.GetWorldTransform());
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
 #include "transform.h"
 #include "sprite.h"
 #include "collider.h"
@@ -30,8 +31,14 @@ public:
 
     /**
      * @brief Destructor for GameObject
+     * Detaches the object from its parent. Children become roots and keep
+     * their current world transform.
      */
-    virtual ~GameObject() = default;
+    virtual ~GameObject();
+
+    // Parent and child links are raw pointers, so copying would corrupt the hierarchy
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
 
     /**
      * @brief Update the game object and its components
@@ -44,6 +51,18 @@ public:
      */
     virtual void Render();
 
+    /**
+     * @brief Get the world-space area this object draws to
+     *
+     * Used by the scene for camera culling and to track which parts of the
+     * screen changed between frames (without a camera, world space is screen
+     * space). The default covers the sprite; subclasses that draw anything
+     * else in Render() must override this.
+     * @param bounds Receives the bounding rectangle (empty if nothing is drawn)
+     * @return False if the drawn area cannot be determined
+     */
+    virtual bool GetRenderBounds(SDL_Rect& bounds) const;
+
     /**
      * @brief Set the sprite component for this game object
      * @param sprite Shared pointer to the sprite component
@@ -68,6 +87,68 @@ public:
      */
     Transform& GetTransform() { return transform; }
 
+    /**
+     * @brief Attach this object to a parent
+     *
+     * The object's transform becomes relative to the parent's world transform.
+     * The parent does not own its children; both must be kept alive elsewhere,
+     * usually by a Scene.
+     * @param newParent Parent object, or nullptr to make this a root object
+     * @param keepWorldTransform True to adjust the local transform so the
+     *        object stays where it is in the world
+     * @return False if newParent is this object or one of its descendants
+     */
+    bool SetParent(GameObject* newParent, bool keepWorldTransform = true);
+
+    /**
+     * @brief Get the parent object
+     * @return Parent, or nullptr for root objects
+     */
+    [[nodiscard]] GameObject* GetParent() const { return parent; }
+
+    /**
+     * @brief Get the objects attached to this object
+     * @return Direct children in the order they were attached
+     */
+    [[nodiscard]] const std::vector<GameObject*>& GetChildren() const { return children; }
+
+    /**
+     * @brief Get the number of ancestors above this object
+     * @return 0 for root objects
+     */
+    [[nodiscard]] int GetHierarchyDepth() const { return hierarchyDepth; }
+
+    /**
+     * @brief Get the local-to-world matrix including all parents
+     *
+     * Computed lazily: the product is only rebuilt when this object's
+     * transform or one of its ancestors' world matrices changed.
+     * @return World matrix
+     */
+    [[nodiscard]] const Matrix2D& GetWorldMatrix() const;
+
+    /**
+     * @brief Get the transform in world space
+     * For root objects this is the transform itself.
+     * @return World transform
+     */
+    [[nodiscard]] const Transform& GetWorldTransform() const;
+
+    /**
+     * @brief Recompute the world matrix assuming the parent's is already current
+     *
+     * Scenes call this for every object in hierarchy depth order, so each
+     * parent is refreshed before its children and the whole pass is linear.
+     * Use GetWorldMatrix() everywhere else.
+     */
+    void RefreshWorldMatrix() const;
+
+    /**
+     * @brief Get a counter that changes whenever any parent link changes
+     * @return Current hierarchy generation
+     */
+    [[nodiscard]] static Uint32 GetHierarchyGeneration() { return hierarchyGeneration; }
+
     /**
      * @brief Get the tag for this game object
      * @return Constant reference to the tag
@@ -98,6 +179,41 @@ public:
      */
     void SetActive(const bool active) { isActive = active; }
 
+    /**
+     * @brief Set the render layer; higher layers are drawn on top
+     * Objects on the same layer are drawn in the order they were added.
+     * @param layer Render layer
+     */
+    void SetRenderLayer(int layer) { renderLayer = layer; }
+
+    /**
+     * @brief Get the render layer
+     * @return Render layer
+     */
+    [[nodiscard]] int GetRenderLayer() const { return renderLayer; }
+
+    /**
+     * @brief Pin the object to an update tier instead of picking one by camera distance
+     * Tier 0 updates every frame; see Scene::SetUpdateLodTiers().
+     * @param tier Tier index, or kAutoUpdateTier to pick by distance
+     */
+    void SetUpdateTier(int tier) { updateTier = tier; }
+
+    /**
+     * @brief Get the update tier the object is pinned to
+     * @return Tier index, or kAutoUpdateTier
+     */
+    [[nodiscard]] int GetUpdateTier() const { return updateTier; }
+
+    static constexpr int kAutoUpdateTier = -1;
+
+    /**
+     * @brief Get a counter that changes whenever the object's drawing changes
+     * in ways not visible through its transform or sprite
+     * @return Current render version
+     */
+    [[nodiscard]] Uint32 GetRenderVersion() const { return renderVersion; }
+
     /**
      * @brief Check for collision with another game object
      * @param other Game object to check for collision
@@ -118,11 +234,52 @@ public:
     virtual void OnCollisionExit(GameObject* other) {}
 
 protected:
+    /**
+     * @brief Signal that Render() output changed without a transform or sprite change
+     * Subclasses with custom drawing call this so retained rendering redraws them.
+     */
+    void MarkRenderDirty() { ++renderVersion; }
+
     Transform transform; ///< Transform component for this game object
     std::shared_ptr<Sprite> sprite; ///< Sprite component for this game object
     std::shared_ptr<Collider> collider; ///< Collider component for this game object
     std::string tag; ///< Tag for this game object
     bool isActive; ///< Active state flag
+    Uint32 renderVersion = 0; ///< Bumped by MarkRenderDirty()
+    int renderLayer = 0; ///< Draw order, higher layers on top
+    int updateTier = kAutoUpdateTier; ///< Pinned update tier
+
+private:
+    friend class Scene;
+
+    /**
+     * @brief Refresh world matrices from the root down to this object
+     */
+    void UpdateWorldMatrix() const;
+
+    /**
+     * @brief Recompute hierarchy depth for this object and its descendants
+     */
+    void UpdateHierarchyDepth();
+
+    GameObject* parent = nullptr; ///< Parent in the transform hierarchy
+    std::vector<GameObject*> children; ///< Objects attached to this one
+    int hierarchyDepth = 0; ///< Number of ancestors
+
+    // Lazily computed world matrix and the versions it was built from
+    mutable Matrix2D worldMatrix;
+    mutable Transform worldTransform;
+    mutable unsigned int worldVersion = 0; ///< Bumped whenever worldMatrix changes
+    mutable unsigned int localVersionSeen = 0;
+    mutable unsigned int parentVersionSeen = 0;
+    mutable bool worldValid = false;
+
+    // Update LOD scheduling, maintained by Scene
+    float pendingUpdateTime = 0.0f; ///< Time accumulated since the last Update()
+    Uint32 updateInterval = 1; ///< Frames between updates in the current tier
+    Uint32 framesUntilUpdate = 0;
+
+    static inline Uint32 hierarchyGeneration = 0;
 };
 
 /**
@@ -0,0 +1,49 @@
+/**
+ * @file mappedfile.h
+ * @brief Read-only memory-mapped file
+ *
+ * Maps a whole file into the address space so its contents can be read
+ * without copying. Pages are loaded by the OS on first access.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Prevent copying; the mapping has a single owner
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file, replacing any current mapping
+     * @param path File to map
+     * @return False if the file cannot be opened or mapped
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Unmap the file
+     */
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return opened; }
+    [[nodiscard]] const std::uint8_t* GetData() const { return data; }
+    [[nodiscard]] size_t GetSize() const { return size; }
+
+private:
+    const std::uint8_t* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
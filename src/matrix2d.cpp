@@ -0,0 +1,44 @@
+#include "matrix2d.h"
+
+Matrix2D::Matrix2D() : a(1.0f), b(0.0f), c(0.0f), d(1.0f), tx(0.0f), ty(0.0f) {}
+
+Matrix2D::Matrix2D(float a, float b, float c, float d, float tx, float ty)
+    : a(a), b(b), c(c), d(d), tx(tx), ty(ty) {}
+
+Matrix2D Matrix2D::FromTRS(const Vector2D& position, float sinR, float cosR, const Vector2D& scale) {
+    return Matrix2D(
+        cosR * scale.x, sinR * scale.x,
+        -sinR * scale.y, cosR * scale.y,
+        position.x, position.y
+    );
+}
+
+Matrix2D Matrix2D::Inverse() const {
+    float det = a * d - b * c;
+    if (det == 0.0f) {
+        return Matrix2D();
+    }
+
+    float invDet = 1.0f / det;
+    float ia = d * invDet;
+    float ib = -b * invDet;
+    float ic = -c * invDet;
+    float id = a * invDet;
+    return Matrix2D(
+        ia, ib,
+        ic, id,
+        -(ia * tx + ic * ty),
+        -(ib * tx + id * ty)
+    );
+}
+
+Matrix2D Matrix2D::operator*(const Matrix2D& other) const {
+    return Matrix2D(
+        a * other.a + c * other.b,
+        b * other.a + d * other.b,
+        a * other.c + c * other.d,
+        b * other.c + d * other.d,
+        a * other.tx + c * other.ty + tx,
+        b * other.tx + d * other.ty + ty
+    );
+}
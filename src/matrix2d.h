@@ -0,0 +1,48 @@
+#pragma once
+#include "vector2d.h"
+
+/**
+ * @brief 2x3 affine matrix for 2D transformations
+ *
+ * Maps a point p to (a * p.x + c * p.y + tx, b * p.x + d * p.y + ty),
+ * i.e. the columns (a, b) and (c, d) are the transformed x and y axes.
+ */
+class Matrix2D {
+public:
+    float a, b, c, d, tx, ty;
+
+    Matrix2D();
+    Matrix2D(float a, float b, float c, float d, float tx, float ty);
+
+    /**
+     * @brief Build a scale, then rotate, then translate matrix
+     * @param position Translation
+     * @param sinR Sine of the rotation angle
+     * @param cosR Cosine of the rotation angle
+     * @param scale Scale along the local axes
+     */
+    static Matrix2D FromTRS(const Vector2D& position, float sinR, float cosR, const Vector2D& scale);
+
+    Vector2D TransformPoint(const Vector2D& point) const {
+        return Vector2D(a * point.x + c * point.y + tx, b * point.x + d * point.y + ty);
+    }
+
+    Vector2D TransformVector(const Vector2D& vec) const {
+        return Vector2D(a * vec.x + c * vec.y, b * vec.x + d * vec.y);
+    }
+
+    // Inverse of this matrix (identity if the matrix is singular)
+    Matrix2D Inverse() const;
+
+    // Combined transform that applies other first, then this
+    Matrix2D operator*(const Matrix2D& other) const;
+
+    bool operator==(const Matrix2D& other) const {
+        return a == other.a && b == other.b && c == other.c &&
+               d == other.d && tx == other.tx && ty == other.ty;
+    }
+
+    bool operator!=(const Matrix2D& other) const {
+        return !(*this == other);
+    }
+};
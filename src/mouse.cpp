@@ -1,5 +1,7 @@
 #include "mouse.h"
 
+#include <game.h>
+
 Mouse& Mouse::Instance() {
     static Mouse instance;
     return instance;
@@ -35,12 +37,19 @@ bool Mouse::IsButtonJustReleased(int button) const {
 void Mouse::Update() {
     previousButtonState = currentButtonState;
 
+    // Convert window coordinates into the game's render resolution
+    const Game& game = Game::Instance();
+    float scaleX = game.GetWindowWidth() > 0
+        ? static_cast<float>(game.GetRenderWidth()) / game.GetWindowWidth() : 1.0f;
+    float scaleY = game.GetWindowHeight() > 0
+        ? static_cast<float>(game.GetRenderHeight()) / game.GetWindowHeight() : 1.0f;
+
     int x, y;
     currentButtonState = SDL_GetMouseState(&x, &y);
-    position = Vector2D(static_cast<float>(x), static_cast<float>(y));
+    position = Vector2D(x * scaleX, y * scaleY);
 
     // Get relative motion
     int relX, relY;
     SDL_GetRelativeMouseState(&relX, &relY);
-    relativeMotion = Vector2D(static_cast<float>(relX), static_cast<float>(relY));
+    relativeMotion = Vector2D(relX * scaleX, relY * scaleY);
 }
\ No newline at end of file
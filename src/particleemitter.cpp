@@ -0,0 +1,234 @@
+#include "particleemitter.h"
+
+#include <camera.h>
+#include <debug/metrics.h>
+#include <game.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+ParticleEmitter::ParticleEmitter(size_t capacity, std::string tag)
+    : GameObject(std::move(tag))
+    , capacity(capacity)
+    , rng(std::random_device{}())
+    , posX(capacity)
+    , posY(capacity)
+    , velX(capacity)
+    , velY(capacity)
+    , age(capacity)
+    , ageRate(capacity)
+    , vertexPositions(capacity * 8)
+    , vertexColors(capacity * 4)
+    , vertexUVs(capacity * 8)
+    , indices(capacity * 6)
+{
+    // Texture coordinates and indices are identical for every quad,
+    // so they are built once instead of every frame
+    static const float quadUVs[8] = {0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
+    for (size_t i = 0; i < capacity; ++i) {
+        std::copy(quadUVs, quadUVs + 8, vertexUVs.begin() + i * 8);
+
+        const int base = static_cast<int>(i * 4);
+        int* quad = &indices[i * 6];
+        quad[0] = base;
+        quad[1] = base + 1;
+        quad[2] = base + 2;
+        quad[3] = base;
+        quad[4] = base + 2;
+        quad[5] = base + 3;
+    }
+}
+
+void ParticleEmitter::Update(float deltaTime) {
+    if (!isActive) return;
+
+    Simulate(deltaTime);
+    RemoveDeadParticles();
+
+    if (emitting && config.emissionRate > 0.0f) {
+        emissionAccumulator += config.emissionRate * deltaTime;
+        auto count = static_cast<size_t>(emissionAccumulator);
+        emissionAccumulator -= static_cast<float>(count);
+        Emit(count);
+    }
+
+    if (aliveCount > 0 || hadParticles) {
+        MarkRenderDirty();
+    }
+    hadParticles = aliveCount > 0;
+}
+
+void ParticleEmitter::Simulate(float deltaTime) {
+    const size_t n = aliveCount;
+    const float gx = config.gravity.x * deltaTime;
+    const float gy = config.gravity.y * deltaTime;
+
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    float* __restrict vx = velX.data();
+    float* __restrict vy = velY.data();
+    float* __restrict a = age.data();
+    const float* __restrict rate = ageRate.data();
+
+    // Each loop touches only the arrays it needs so they vectorize cleanly
+    for (size_t i = 0; i < n; ++i) {
+        vx[i] += gx;
+        vy[i] += gy;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        a[i] += rate[i] * deltaTime;
+    }
+}
+
+void ParticleEmitter::RemoveDeadParticles() {
+    size_t i = 0;
+    while (i < aliveCount) {
+        if (age[i] >= 1.0f) {
+            // Swap the last live particle into this slot to keep the pool dense
+            const size_t last = --aliveCount;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            age[i] = age[last];
+            ageRate[i] = ageRate[last];
+        } else {
+            ++i;
+        }
+    }
+}
+
+void ParticleEmitter::Emit(size_t count) {
+    count = std::min(count, capacity - aliveCount);
+    if (count == 0) return;
+
+    const Vector2D origin = GetWorldTransform().position;
+    const float baseAngle = config.direction - config.spread / 2.0f;
+
+    for (size_t n = 0; n < count; ++n) {
+        const size_t i = aliveCount++;
+
+        float radians = (baseAngle + RandomRange(0.0f, config.spread)) * (M_PI / 180.0f);
+        float speed = RandomRange(config.minSpeed, config.maxSpeed);
+        float lifetime = RandomRange(config.minLifetime, config.maxLifetime);
+
+        posX[i] = origin.x + RandomRange(-config.spawnExtents.x, config.spawnExtents.x);
+        posY[i] = origin.y + RandomRange(-config.spawnExtents.y, config.spawnExtents.y);
+        velX[i] = std::cos(radians) * speed;
+        velY[i] = std::sin(radians) * speed;
+        age[i] = 0.0f;
+        ageRate[i] = lifetime > 0.0f ? 1.0f / lifetime : 1.0f;
+    }
+}
+
+void ParticleEmitter::Render() {
+    if (!isActive || aliveCount == 0) return;
+
+    SDL_Renderer* renderer = Game::Instance().GetRenderer();
+    if (!renderer) return;
+
+    BuildVertices();
+
+    if (texture) {
+        SDL_SetTextureBlendMode(texture.get(), config.blendMode);
+    } else {
+        SDL_SetRenderDrawBlendMode(renderer, config.blendMode);
+    }
+
+    SDL_RenderGeometryRaw(
+        renderer,
+        texture.get(),
+        vertexPositions.data(), sizeof(float) * 2,
+        vertexColors.data(), sizeof(SDL_Color),
+        vertexUVs.data(), sizeof(float) * 2,
+        static_cast<int>(aliveCount * 4),
+        indices.data(), static_cast<int>(aliveCount * 6), sizeof(int)
+    );
+
+    static Metrics::Counter& drawCalls = Metrics::Instance().GetCounter("render.draw_calls");
+    drawCalls.Add();
+}
+
+bool ParticleEmitter::GetRenderBounds(SDL_Rect& bounds) const {
+    if (aliveCount == 0) {
+        const Vector2D& origin = GetWorldTransform().position;
+        bounds = {static_cast<int>(origin.x), static_cast<int>(origin.y), 0, 0};
+        return true;
+    }
+
+    auto [minX, maxX] = std::minmax_element(posX.begin(), posX.begin() + aliveCount);
+    auto [minY, maxY] = std::minmax_element(posY.begin(), posY.begin() + aliveCount);
+    float half = std::max(config.startSize, config.endSize) / 2.0f + 1.0f;
+
+    int left = static_cast<int>(std::floor(*minX - half));
+    int top = static_cast<int>(std::floor(*minY - half));
+    int right = static_cast<int>(std::ceil(*maxX + half));
+    int bottom = static_cast<int>(std::ceil(*maxY + half));
+    bounds = {left, top, right - left, bottom - top};
+    return true;
+}
+
+void ParticleEmitter::BuildVertices() {
+    const SDL_Color& c0 = config.startColor;
+    const SDL_Color& c1 = config.endColor;
+    const float dr = static_cast<float>(c1.r) - c0.r;
+    const float dg = static_cast<float>(c1.g) - c0.g;
+    const float db = static_cast<float>(c1.b) - c0.b;
+    const float da = static_cast<float>(c1.a) - c0.a;
+    float halfStart = config.startSize / 2.0f;
+    float halfDelta = (config.endSize - config.startSize) / 2.0f;
+
+    // World to screen is affine: screen = origin + x * axisX + y * axisY
+    Vector2D origin(0.0f, 0.0f);
+    Vector2D axisX(1.0f, 0.0f);
+    Vector2D axisY(0.0f, 1.0f);
+    if (const Camera* camera = Camera::GetActive()) {
+        const Matrix2D& view = camera->GetViewMatrix();
+        origin = Vector2D(view.tx, view.ty);
+        axisX = Vector2D(view.a, view.b);
+        axisY = Vector2D(view.c, view.d);
+        halfStart *= camera->GetZoom();
+        halfDelta *= camera->GetZoom();
+    }
+
+    float* xy = vertexPositions.data();
+    SDL_Color* colors = vertexColors.data();
+
+    for (size_t i = 0; i < aliveCount; ++i) {
+        const float t = age[i];
+        const float half = halfStart + halfDelta * t;
+        const float sx = origin.x + posX[i] * axisX.x + posY[i] * axisY.x;
+        const float sy = origin.y + posX[i] * axisX.y + posY[i] * axisY.y;
+        const float x0 = sx - half;
+        const float y0 = sy - half;
+        const float x1 = sx + half;
+        const float y1 = sy + half;
+
+        float* v = xy + i * 8;
+        v[0] = x0; v[1] = y0;
+        v[2] = x1; v[3] = y0;
+        v[4] = x1; v[5] = y1;
+        v[6] = x0; v[7] = y1;
+
+        const SDL_Color color{
+            static_cast<Uint8>(c0.r + dr * t),
+            static_cast<Uint8>(c0.g + dg * t),
+            static_cast<Uint8>(c0.b + db * t),
+            static_cast<Uint8>(c0.a + da * t)
+        };
+        SDL_Color* c = colors + i * 4;
+        c[0] = color;
+        c[1] = color;
+        c[2] = color;
+        c[3] = color;
+    }
+}
+
+float ParticleEmitter::RandomRange(float min, float max) {
+    if (max <= min) return min;
+    return std::uniform_real_distribution<float>(min, max)(rng);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file particleemitter.h
+ * @brief Pooled particle emitter with structure-of-arrays storage
+ *
+ * A ParticleEmitter owns a fixed-capacity pool of particles. Each particle
+ * attribute lives in its own contiguous array so the per-frame update is a
+ * handful of tight loops the compiler can vectorize, and dead particles are
+ * swapped out so live particles always occupy the front of the pool.
+ * All live particles of an emitter are submitted to the renderer in a single
+ * SDL_RenderGeometryRaw call.
+ */
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "gameobject.h"
+
+/**
+ * @class ParticleEmitter
+ * @brief GameObject that simulates and renders a pool of particles
+ *
+ * The emitter spawns particles at its world position. Particles are
+ * simulated in world space, so moving the emitter does not drag already
+ * spawned particles along with it.
+ */
+class ParticleEmitter : public GameObject {
+public:
+    // Configuration for particle emission
+    struct Config {
+        float emissionRate = 50.0f;              // Particles spawned per second while emitting
+        float minLifetime = 1.0f;                // Lifetime range in seconds
+        float maxLifetime = 1.0f;
+        float minSpeed = 50.0f;                  // Initial speed range in pixels per second
+        float maxSpeed = 100.0f;
+        float direction = 0.0f;                  // Emission direction in degrees
+        float spread = 360.0f;                   // Emission cone width in degrees
+        float startSize = 8.0f;                  // Quad size at spawn in pixels
+        float endSize = 8.0f;                    // Quad size at death in pixels
+        SDL_Color startColor{255, 255, 255, 255};
+        SDL_Color endColor{255, 255, 255, 0};
+        Vector2D gravity;                        // Constant acceleration in pixels per second^2
+        Vector2D spawnExtents;                   // Half size of the spawn area around the emitter
+        SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    };
+
+    /**
+     * @brief Constructor for ParticleEmitter
+     * @param capacity Maximum number of simultaneously live particles
+     * @param tag Optional tag for the object
+     */
+    explicit ParticleEmitter(size_t capacity, std::string tag = "");
+
+    /**
+     * @brief Advance the simulation and spawn new particles
+     * @param deltaTime Time elapsed since last frame
+     */
+    void Update(float deltaTime) override;
+
+    /**
+     * @brief Draw all live particles in a single geometry call
+     */
+    void Render() override;
+
+    /**
+     * @brief Get the screen area covered by all live particles
+     */
+    bool GetRenderBounds(SDL_Rect& bounds) const override;
+
+    /**
+     * @brief Spawn a burst of particles immediately
+     * @param count Number of particles to spawn (clamped to free capacity)
+     */
+    void Emit(size_t count);
+
+    /**
+     * @brief Kill all live particles
+     */
+    void Clear() { aliveCount = 0; }
+
+    /**
+     * @brief Set the texture drawn on each particle quad
+     * @param tex Texture to use, or nullptr for flat colored quads
+     */
+    void SetTexture(std::shared_ptr<SDL_Texture> tex) { texture = std::move(tex); }
+
+    /**
+     * @brief Enable or disable continuous emission
+     * @param enabled True to spawn particles at the configured rate
+     */
+    void SetEmitting(bool enabled) { emitting = enabled; }
+
+    void SetConfig(const Config& newConfig) { config = newConfig; }
+
+    [[nodiscard]] const Config& GetConfig() const { return config; }
+    [[nodiscard]] bool IsEmitting() const { return emitting; }
+    [[nodiscard]] size_t GetAliveCount() const { return aliveCount; }
+    [[nodiscard]] size_t GetCapacity() const { return capacity; }
+    [[nodiscard]] SDL_Texture* GetTexture() const { return texture.get(); }
+
+    /**
+     * @brief Get the position of a live particle
+     * @param index Index in [0, GetAliveCount())
+     * @return Particle position in world coordinates
+     */
+    [[nodiscard]] Vector2D GetParticlePosition(size_t index) const {
+        return Vector2D(posX[index], posY[index]);
+    }
+
+private:
+    /**
+     * @brief Integrate velocity, position and age for all live particles
+     */
+    void Simulate(float deltaTime);
+
+    /**
+     * @brief Remove particles whose age reached their lifetime
+     */
+    void RemoveDeadParticles();
+
+    /**
+     * @brief Fill the vertex position and color arrays for all live particles
+     */
+    void BuildVertices();
+
+    float RandomRange(float min, float max);
+
+    Config config;
+    size_t capacity;
+    size_t aliveCount = 0;
+    float emissionAccumulator = 0.0f;
+    bool emitting = true;
+    bool hadParticles = false;       ///< Whether particles were alive after the last update
+    std::shared_ptr<SDL_Texture> texture;
+    std::mt19937 rng;
+
+    // Particle attributes, one array per attribute (structure of arrays)
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> age;          ///< Normalized age in [0, 1)
+    std::vector<float> ageRate;      ///< 1 / lifetime, so age advances by ageRate * dt
+
+    // Geometry submitted to SDL_RenderGeometryRaw (4 vertices per particle)
+    std::vector<float> vertexPositions;
+    std::vector<SDL_Color> vertexColors;
+    std::vector<float> vertexUVs;    ///< Constant per quad, built once
+    std::vector<int> indices;        ///< Constant per quad, built once
+};
@@ -0,0 +1,86 @@
+#include "postprocess.h"
+
+#include <game.h>
+#include <algorithm>
+
+void ColorModulateEffect::Apply(SDL_Renderer* renderer, SDL_Texture* source, const SDL_Rect* destRect) {
+    SDL_SetTextureColorMod(source, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(source, color.a);
+    SDL_RenderCopy(renderer, source, nullptr, destRect);
+    SDL_SetTextureColorMod(source, 255, 255, 255);
+    SDL_SetTextureAlphaMod(source, 255);
+}
+
+void FadeEffect::SetAmount(float newAmount) {
+    amount = std::clamp(newAmount, 0.0f, 1.0f);
+}
+
+void FadeEffect::Apply(SDL_Renderer* renderer, SDL_Texture* source, const SDL_Rect* destRect) {
+    SDL_RenderCopy(renderer, source, nullptr, destRect);
+    if (amount <= 0.0f) return;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b,
+                           static_cast<Uint8>(color.a * amount));
+    SDL_RenderFillRect(renderer, destRect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+void PostProcessChain::AddEffect(std::shared_ptr<PostProcessEffect> effect) {
+    if (effect) {
+        effects.push_back(std::move(effect));
+    }
+}
+
+void PostProcessChain::RemoveEffect(const std::shared_ptr<PostProcessEffect>& effect) {
+    effects.erase(std::remove(effects.begin(), effects.end(), effect), effects.end());
+}
+
+bool PostProcessChain::HasActiveEffects() const {
+    return std::any_of(effects.begin(), effects.end(),
+        [](const auto& effect) { return effect->IsEnabled(); });
+}
+
+void PostProcessChain::Present(RenderTarget& source, const SDL_Rect* destRect) {
+    SDL_Renderer* renderer = Game::Instance().GetRenderer();
+    if (!renderer) return;
+
+    std::vector<PostProcessEffect*> active;
+    for (const auto& effect : effects) {
+        if (effect->IsEnabled()) {
+            active.push_back(effect.get());
+        }
+    }
+
+    SDL_Texture* current = source.GetTexture();
+    SDL_SetTextureScaleMode(current, scaleMode);
+
+    if (active.empty()) {
+        SDL_RenderCopy(renderer, current, nullptr, destRect);
+        return;
+    }
+
+    // Every pass but the last renders at source resolution into a ping-pong buffer
+    for (size_t i = 0; i + 1 < active.size(); ++i) {
+        RenderTarget& target = GetIntermediate(i % 2, source.GetWidth(), source.GetHeight());
+        target.Clear({0, 0, 0, 0});
+        target.Begin();
+        active[i]->Apply(renderer, current, nullptr);
+        target.End();
+
+        current = target.GetTexture();
+        SDL_SetTextureScaleMode(current, scaleMode);
+    }
+
+    active.back()->Apply(renderer, current, destRect);
+}
+
+RenderTarget& PostProcessChain::GetIntermediate(size_t index, int width, int height) {
+    auto& target = intermediates[index];
+    if (!target) {
+        target = std::make_unique<RenderTarget>(width, height);
+    } else {
+        target->Resize(width, height);
+    }
+    return *target;
+}
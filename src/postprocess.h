@@ -0,0 +1,116 @@
+/**
+ * @file postprocess.h
+ * @brief Composable full-screen effects applied to a rendered frame
+ *
+ * A PostProcessChain takes a RenderTarget holding a rendered frame, runs it
+ * through a list of effects and draws the result to the current render
+ * target. Intermediate passes run at the source resolution; only the final
+ * pass scales to the output, so a frame rendered at a low internal
+ * resolution is upscaled exactly once.
+ */
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+#include <vector>
+#include "rendertarget.h"
+
+/**
+ * @brief Base class for a single post-processing pass
+ */
+class PostProcessEffect {
+public:
+    virtual ~PostProcessEffect() = default;
+
+    /**
+     * @brief Draw the source texture into the current render target
+     * @param renderer Renderer to draw with
+     * @param source Output of the previous pass
+     * @param destRect Area to cover, or nullptr for the whole target
+     */
+    virtual void Apply(SDL_Renderer* renderer, SDL_Texture* source, const SDL_Rect* destRect) = 0;
+
+    void SetEnabled(bool isEnabled) { enabled = isEnabled; }
+    [[nodiscard]] bool IsEnabled() const { return enabled; }
+
+private:
+    bool enabled = true;
+};
+
+/**
+ * @brief Tints the frame by multiplying it with a color
+ */
+class ColorModulateEffect : public PostProcessEffect {
+public:
+    explicit ColorModulateEffect(const SDL_Color& color = {255, 255, 255, 255}) : color(color) {}
+
+    void Apply(SDL_Renderer* renderer, SDL_Texture* source, const SDL_Rect* destRect) override;
+
+    void SetColor(const SDL_Color& newColor) { color = newColor; }
+    [[nodiscard]] const SDL_Color& GetColor() const { return color; }
+
+private:
+    SDL_Color color;
+};
+
+/**
+ * @brief Blends the frame towards a solid color
+ */
+class FadeEffect : public PostProcessEffect {
+public:
+    explicit FadeEffect(const SDL_Color& color = {0, 0, 0, 255}, float amount = 0.0f)
+        : color(color), amount(amount) {}
+
+    void Apply(SDL_Renderer* renderer, SDL_Texture* source, const SDL_Rect* destRect) override;
+
+    void SetColor(const SDL_Color& newColor) { color = newColor; }
+
+    /**
+     * @brief Set how far the frame is faded
+     * @param newAmount 0 = untouched frame, 1 = solid color
+     */
+    void SetAmount(float newAmount);
+
+    [[nodiscard]] const SDL_Color& GetColor() const { return color; }
+    [[nodiscard]] float GetAmount() const { return amount; }
+
+private:
+    SDL_Color color;
+    float amount;
+};
+
+/**
+ * @brief Ordered list of effects applied when presenting a frame
+ */
+class PostProcessChain {
+public:
+    void AddEffect(std::shared_ptr<PostProcessEffect> effect);
+    void RemoveEffect(const std::shared_ptr<PostProcessEffect>& effect);
+    void ClearEffects() { effects.clear(); }
+
+    /**
+     * @brief Set the filtering used when the final pass scales to the output
+     */
+    void SetScaleMode(SDL_ScaleMode mode) { scaleMode = mode; }
+
+    /**
+     * @brief Check if any enabled effect is in the chain
+     */
+    [[nodiscard]] bool HasActiveEffects() const;
+
+    [[nodiscard]] SDL_ScaleMode GetScaleMode() const { return scaleMode; }
+    [[nodiscard]] const std::vector<std::shared_ptr<PostProcessEffect>>& GetEffects() const { return effects; }
+
+    /**
+     * @brief Run all enabled effects on a frame and draw the result
+     * @param source Rendered frame
+     * @param destRect Output area in the current render target, or nullptr for all of it
+     */
+    void Present(RenderTarget& source, const SDL_Rect* destRect = nullptr);
+
+private:
+    RenderTarget& GetIntermediate(size_t index, int width, int height);
+
+    std::vector<std::shared_ptr<PostProcessEffect>> effects;
+    std::unique_ptr<RenderTarget> intermediates[2];  ///< Ping-pong buffers between passes
+    SDL_ScaleMode scaleMode = SDL_ScaleModeLinear;
+};
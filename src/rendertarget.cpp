@@ -0,0 +1,78 @@
+#include "rendertarget.h"
+
+#include <game.h>
+#include <stdexcept>
+#include <utility>
+
+RenderTarget::RenderTarget(int width, int height)
+    : renderer(Game::Instance().GetRenderer())
+    , width(width)
+    , height(height)
+{
+    texture = CreateTexture(width, height);
+}
+
+std::shared_ptr<SDL_Texture> RenderTarget::CreateTexture(int textureWidth, int textureHeight) const {
+    if (!renderer) {
+        throw std::runtime_error("Cannot create render target without a renderer");
+    }
+
+    SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                         SDL_TEXTUREACCESS_TARGET, textureWidth, textureHeight);
+    if (!tex) {
+        throw std::runtime_error(SDL_GetError());
+    }
+
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(tex, scaleMode);
+    return std::shared_ptr<SDL_Texture>(tex, SDL_DestroyTexture);
+}
+
+void RenderTarget::Begin() {
+    if (bound) return;
+
+    previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, texture.get());
+    bound = true;
+}
+
+void RenderTarget::End() {
+    if (!bound) return;
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    previousTarget = nullptr;
+    bound = false;
+}
+
+void RenderTarget::Clear(const SDL_Color& color) {
+    bool wasBound = bound;
+    Begin();
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderClear(renderer);
+    if (!wasBound) {
+        End();
+    }
+}
+
+void RenderTarget::Resize(int newWidth, int newHeight) {
+    if (newWidth == width && newHeight == height) return;
+
+    // Create first so a failure leaves the target as it was
+    auto newTexture = CreateTexture(newWidth, newHeight);
+
+    bool wasBound = bound;
+    End();
+
+    texture = std::move(newTexture);
+    width = newWidth;
+    height = newHeight;
+
+    if (wasBound) {
+        Begin();
+    }
+}
+
+void RenderTarget::SetScaleMode(SDL_ScaleMode mode) {
+    scaleMode = mode;
+    SDL_SetTextureScaleMode(texture.get(), mode);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file rendertarget.h
+ * @brief Offscreen texture that scenes and cameras can render into
+ *
+ * A RenderTarget wraps an SDL_Texture created with SDL_TEXTUREACCESS_TARGET.
+ * Drawing between Begin() and End() goes into the texture instead of the
+ * window, and the texture can then be composited, post-processed or scaled.
+ */
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+
+class RenderTarget {
+public:
+    /**
+     * @brief Create a render target using the game's renderer
+     * @param width Width of the target in pixels
+     * @param height Height of the target in pixels
+     * @throws std::runtime_error if the texture cannot be created
+     */
+    RenderTarget(int width, int height);
+
+    // Prevent copying and assignment
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    /**
+     * @brief Redirect rendering into this target
+     * The previously bound target is restored by End().
+     */
+    void Begin();
+
+    /**
+     * @brief Restore the render target that was bound before Begin()
+     */
+    void End();
+
+    /**
+     * @brief Fill the whole target with a color
+     * @param color Clear color
+     */
+    void Clear(const SDL_Color& color = {0, 0, 0, 255});
+
+    /**
+     * @brief Recreate the texture with a new size
+     * Does nothing if the size is unchanged. Contents are lost otherwise.
+     * @throws std::runtime_error if the texture cannot be created
+     */
+    void Resize(int newWidth, int newHeight);
+
+    /**
+     * @brief Set the filtering used when the target is drawn scaled
+     * @param mode SDL_ScaleModeNearest for crisp pixels, SDL_ScaleModeLinear for smooth scaling
+     */
+    void SetScaleMode(SDL_ScaleMode mode);
+
+    [[nodiscard]] SDL_Texture* GetTexture() const { return texture.get(); }
+    [[nodiscard]] int GetWidth() const { return width; }
+    [[nodiscard]] int GetHeight() const { return height; }
+    [[nodiscard]] bool IsBound() const { return bound; }
+
+private:
+    // Throws std::runtime_error if the texture cannot be created
+    std::shared_ptr<SDL_Texture> CreateTexture(int textureWidth, int textureHeight) const;
+
+    SDL_Renderer* renderer;
+    std::shared_ptr<SDL_Texture> texture;
+    int width;
+    int height;
+    SDL_ScaleMode scaleMode = SDL_ScaleModeLinear;
+
+    SDL_Texture* previousTarget = nullptr;  ///< Target bound before Begin()
+    bool bound = false;
+};
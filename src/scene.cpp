@@ -1,7 +1,12 @@
 #include "scene.h"
 #include <algorithm>
+#include <limits>
+#include <camera.h>
+#include <debug/metrics.h>
+#include <debug/profiler.h>
 #include <game.h>
 #include <stdexcept>
+#include <unordered_set>
 
 Scene::~Scene() {
     // Clear collections in specific order to avoid dependency issues
@@ -11,52 +16,444 @@ Scene::~Scene() {
 }
 
 void Scene::Update(float deltaTime) {
+    PROFILE_ZONE("Scene::Update");
+
     // Remove inactive or destroyed objects
-    gameObjects.erase(
-        std::remove_if(gameObjects.begin(), gameObjects.end(),
-            [](const auto& obj) { return !obj || !obj->IsActive(); }),
-        gameObjects.end()
-    );
+    auto removed = std::remove_if(gameObjects.begin(), gameObjects.end(),
+        [](const auto& obj) { return !obj || !obj->IsActive(); });
+    if (removed != gameObjects.end()) {
+        gameObjects.erase(removed, gameObjects.end());
+        hierarchyOrderValid = false;
+    }
 
     // Clean up any expired tagged objects
     CleanupTags();
 
-    // Update remaining objects
-    for (const auto& obj : gameObjects) {
-        if (obj && obj->IsActive()) {
-            try {
-                obj->Update(deltaTime);
-            } catch (const std::exception& e) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                    "Error updating object: %s", e.what());
-            }
-        }
+    tweenManager.Update(deltaTime);
+
+    for (const auto& camera : cameras) {
+        camera->Update(deltaTime);
     }
 
+    animationSystem.Update(deltaTime);
+
+    // Update remaining objects
+    UpdateObjects(deltaTime);
+
+    // Propagate parent movement to children before anything reads positions
+    UpdateWorldTransforms();
+
     // Process collisions if not already doing so
     if (!isProcessingCollisions) {
         CheckCollisions();
     }
+
+    static Metrics::Gauge& objectCount = Metrics::Instance().GetGauge("scene.objects");
+    static Metrics::Gauge& updatedCount = Metrics::Instance().GetGauge("scene.objects_updated");
+    static Metrics::Gauge& collisionCount = Metrics::Instance().GetGauge("scene.collisions");
+    objectCount.Set(static_cast<double>(gameObjects.size()));
+    updatedCount.Set(static_cast<double>(updatedObjectCount));
+    collisionCount.Set(static_cast<double>(activeCollisions.size()));
+}
+
+void Scene::UpdateObjects(float deltaTime) {
+    PROFILE_ZONE("Scene::UpdateObjects");
+    const bool lodEnabled = !updateLodTiers.empty() && !cameras.empty();
+    updateViews.clear();
+    if (lodEnabled) {
+        for (const auto& camera : cameras) {
+            updateViews.push_back(camera->GetViewRect());
+        }
+    }
+
+    updatedObjectCount = 0;
+    for (const auto& obj : gameObjects) {
+        if (!obj || !obj->IsActive()) continue;
+
+        const Uint32 interval = lodEnabled ? GetUpdateInterval(*obj) : 1;
+        if (interval != obj->updateInterval) {
+            // Stagger objects entering a slower tier so they don't all update on the same frame
+            obj->updateInterval = interval;
+            obj->framesUntilUpdate = 1 + updateStagger++ % interval;
+        }
+
+        obj->pendingUpdateTime += deltaTime;
+        if (obj->framesUntilUpdate > 1) {
+            --obj->framesUntilUpdate;
+            continue;
+        }
+        obj->framesUntilUpdate = interval;
+
+        const float elapsed = obj->pendingUpdateTime;
+        obj->pendingUpdateTime = 0.0f;
+        ++updatedObjectCount;
+        try {
+            obj->Update(elapsed);
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "Error updating object: %s", e.what());
+        }
+    }
+}
+
+Uint32 Scene::GetUpdateInterval(const GameObject& obj) const {
+    const int pinned = obj.GetUpdateTier();
+    if (pinned != GameObject::kAutoUpdateTier) {
+        const auto tier = std::min(static_cast<size_t>(std::max(pinned, 0)), updateLodTiers.size() - 1);
+        return updateLodTiers[tier].interval;
+    }
+
+    // Squared distance from the object to the nearest camera view
+    const Vector2D position = obj.GetWorldTransform().GetPosition();
+    float nearest = std::numeric_limits<float>::max();
+    for (const SDL_Rect& view : updateViews) {
+        const float dx = std::max({static_cast<float>(view.x) - position.x, 0.0f,
+                                   position.x - static_cast<float>(view.x + view.w)});
+        const float dy = std::max({static_cast<float>(view.y) - position.y, 0.0f,
+                                   position.y - static_cast<float>(view.y + view.h)});
+        nearest = std::min(nearest, dx * dx + dy * dy);
+    }
+
+    Uint32 interval = updateLodTiers.front().interval;
+    for (const UpdateLodTier& tier : updateLodTiers) {
+        if (nearest < tier.distance * tier.distance) break;
+        interval = tier.interval;
+    }
+    return interval;
+}
+
+void Scene::SetUpdateLodTiers(std::vector<UpdateLodTier> tiers) {
+    std::stable_sort(tiers.begin(), tiers.end(),
+        [](const UpdateLodTier& a, const UpdateLodTier& b) { return a.distance < b.distance; });
+    for (UpdateLodTier& tier : tiers) {
+        tier.interval = std::max<Uint32>(tier.interval, 1);
+    }
+    updateLodTiers = std::move(tiers);
+}
+
+void Scene::UpdateWorldTransforms() {
+    PROFILE_ZONE("Scene::UpdateWorldTransforms");
+    if (!hierarchyOrderValid || hierarchyGeneration != GameObject::GetHierarchyGeneration()) {
+        BuildHierarchyOrder();
+    }
+
+    // Parents come before their children, so no object walks up its ancestors
+    for (const GameObject* obj : hierarchyOrder) {
+        obj->RefreshWorldMatrix();
+    }
+}
+
+void Scene::BuildHierarchyOrder() {
+    hierarchyOrder.clear();
+
+    // Ancestors outside the scene are included so their children see current matrices
+    std::unordered_set<GameObject*> seen;
+    for (const auto& obj : gameObjects) {
+        if (!obj || (!obj->GetParent() && obj->GetChildren().empty())) continue;
+
+        for (GameObject* node = obj.get(); node && seen.insert(node).second; node = node->GetParent()) {
+            hierarchyOrder.push_back(node);
+        }
+    }
+
+    std::stable_sort(hierarchyOrder.begin(), hierarchyOrder.end(),
+        [](const GameObject* a, const GameObject* b) {
+            return a->GetHierarchyDepth() < b->GetHierarchyDepth();
+        });
+
+    hierarchyGeneration = GameObject::GetHierarchyGeneration();
+    hierarchyOrderValid = true;
+}
+
+namespace {
+    // Beyond this many damaged regions a full redraw is cheaper than merging
+    constexpr size_t kMaxDamageRects = 64;
+
+    bool RectsEqual(const SDL_Rect& a, const SDL_Rect& b) {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+    }
 }
 
 void Scene::Render() {
-    if (!Game::Instance().GetRenderer()) return;
+    PROFILE_ZONE("Scene::Render");
+    SDL_Renderer* renderer = Game::Instance().GetRenderer();
+    if (!renderer) return;
+
+    int width = Game::Instance().GetRenderWidth();
+    int height = Game::Instance().GetRenderHeight();
+
+    if (renderTarget) {
+        renderTarget->Begin();
+        width = renderTarget->GetWidth();
+        height = renderTarget->GetHeight();
+        if (!retainedRenderingEnabled) {
+            renderTarget->Clear();
+        }
+    }
+
+    if (!cameras.empty()) {
+        // Sort once, then let every camera cull against the same queue
+        BuildRenderQueue(true);
+        for (const auto& camera : cameras) {
+            RenderCamera(renderer, *camera);
+        }
+    } else {
+        if (retainedRenderingEnabled) {
+            RenderRetained(renderer, width, height);
+        } else {
+            RenderObjects();
+        }
+
+        // Draw debug information if enabled
+        if (debugDrawEnabled) {
+            DrawDebugCollisions(renderer);
+        }
+    }
+
+    if (renderTarget) {
+        renderTarget->End();
+    }
+}
+
+void Scene::RenderObjects() {
+    BuildRenderQueue(false);
+    for (const auto& item : renderQueue) {
+        SafeRenderObject(item.object);
+    }
+}
+
+void Scene::BuildRenderQueue(bool withBounds) {
+    renderQueue.clear();
+    renderQueue.reserve(gameObjects.size());
 
-    // Render all active objects
     for (const auto& obj : gameObjects) {
-        if (obj && obj->IsActive()) {
-            try {
-                obj->Render();
-            } catch (const std::exception& e) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                    "Error rendering object: %s", e.what());
-            }
+        if (!obj || !obj->IsActive()) continue;
+
+        RenderItem item{obj.get(), SDL_Rect{0, 0, 0, 0}, true};
+        if (withBounds) {
+            item.boundsKnown = obj->GetRenderBounds(item.bounds);
+        }
+        renderQueue.push_back(item);
+    }
+
+    auto byLayer = [](const RenderItem& a, const RenderItem& b) {
+        return a.object->GetRenderLayer() < b.object->GetRenderLayer();
+    };
+
+    // Layers rarely change, so the queue is usually already in order
+    if (!std::is_sorted(renderQueue.begin(), renderQueue.end(), byLayer)) {
+        std::stable_sort(renderQueue.begin(), renderQueue.end(), byLayer);
+    }
+}
+
+void Scene::RenderCamera(SDL_Renderer* renderer, const Camera& camera) {
+    const auto& target = camera.GetRenderTarget();
+    if (target) {
+        target->Begin();
+        target->Clear();
+    }
+
+    const SDL_Rect& viewport = camera.GetViewport();
+    SDL_RenderSetClipRect(renderer, &viewport);
+    Camera::SetActive(&camera);
+
+    SDL_Rect view = camera.GetViewRect();
+    for (const auto& item : renderQueue) {
+        if (!item.boundsKnown || SDL_HasIntersection(&item.bounds, &view)) {
+            SafeRenderObject(item.object);
         }
     }
 
-    // Draw debug information if enabled
     if (debugDrawEnabled) {
-        DrawDebugCollisions(Game::Instance().GetRenderer());
+        DrawDebugCollisions(renderer);
+    }
+
+    Camera::SetActive(nullptr);
+    SDL_RenderSetClipRect(renderer, nullptr);
+
+    if (target) {
+        target->End();
+    }
+}
+
+void Scene::AddCamera(std::shared_ptr<Camera> camera) {
+    if (!camera) {
+        throw std::invalid_argument("Cannot add null Camera");
+    }
+
+    if (std::find(cameras.begin(), cameras.end(), camera) == cameras.end()) {
+        cameras.push_back(std::move(camera));
+    }
+}
+
+void Scene::RemoveCamera(const std::shared_ptr<Camera>& camera) {
+    cameras.erase(std::remove(cameras.begin(), cameras.end(), camera), cameras.end());
+}
+
+void Scene::SetRetainedRenderingEnabled(bool enabled) {
+    retainedRenderingEnabled = enabled;
+    retainedFrameValid = false;
+
+    if (!enabled) {
+        retainedFrame.reset();
+        renderSnapshots.clear();
+        renderQueue.clear();
+        damagedRects.clear();
+    }
+}
+
+void Scene::RenderRetained(SDL_Renderer* renderer, int width, int height) {
+    try {
+        if (!retainedFrame) {
+            retainedFrame = std::make_unique<RenderTarget>(width, height);
+            retainedFrameValid = false;
+        } else if (retainedFrame->GetWidth() != width || retainedFrame->GetHeight() != height) {
+            retainedFrame->Resize(width, height);
+            retainedFrameValid = false;
+        }
+    } catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+            "Failed to create retained frame, disabling retained rendering: %s", e.what());
+        SetRetainedRenderingEnabled(false);
+        RenderObjects();
+        return;
+    }
+
+    // Collect damage first so snapshots stay current even on full redraws
+    bool boundsKnown = CollectDamage();
+    if (!boundsKnown || !retainedFrameValid || !MergeDamage()) {
+        damagedRects.assign(1, SDL_Rect{0, 0, width, height});
+    }
+
+    if (!damagedRects.empty()) {
+        retainedFrame->Begin();
+
+        for (const auto& rect : damagedRects) {
+            SDL_RenderSetClipRect(renderer, &rect);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderFillRect(renderer, &rect);
+
+            for (const auto& item : renderQueue) {
+                if (SDL_HasIntersection(&item.bounds, &rect)) {
+                    SafeRenderObject(item.object);
+                }
+            }
+        }
+
+        SDL_RenderSetClipRect(renderer, nullptr);
+        retainedFrame->End();
+        retainedFrameValid = true;
+    }
+
+    SDL_RenderCopy(renderer, retainedFrame->GetTexture(), nullptr, nullptr);
+    static Metrics::Counter& drawCalls = Metrics::Instance().GetCounter("render.draw_calls");
+    drawCalls.Add();
+}
+
+bool Scene::CollectDamage() {
+    ++renderFrame;
+    damagedRects.clear();
+    BuildRenderQueue(true);
+
+    const SDL_Rect screen{0, 0, retainedFrame->GetWidth(), retainedFrame->GetHeight()};
+    bool boundsKnown = true;
+
+    for (auto& item : renderQueue) {
+        if (!item.boundsKnown) {
+            item.bounds = screen;
+            boundsKnown = false;
+        }
+
+        const GameObject* obj = item.object;
+        const SDL_Rect& bounds = item.bounds;
+        const Transform& transform = obj->GetWorldTransform();
+        const Sprite* sprite = obj->GetSprite().get();
+        Uint32 spriteVersion = sprite ? sprite->GetVersion() : 0;
+
+        auto [it, inserted] = renderSnapshots.try_emplace(obj);
+        RenderSnapshot& snapshot = it->second;
+
+        if (inserted) {
+            damagedRects.push_back(bounds);
+        } else if (!RectsEqual(snapshot.bounds, bounds) ||
+                   snapshot.position != transform.position ||
+                   snapshot.scale != transform.scale ||
+                   snapshot.rotation != transform.rotation ||
+                   snapshot.sprite != sprite ||
+                   snapshot.spriteVersion != spriteVersion ||
+                   snapshot.renderVersion != obj->GetRenderVersion()) {
+            // Both where the object was and where it is now must be redrawn
+            damagedRects.push_back(snapshot.bounds);
+            damagedRects.push_back(bounds);
+        }
+
+        snapshot = {bounds, transform.position, transform.scale, transform.rotation,
+                    sprite, spriteVersion, obj->GetRenderVersion(), renderFrame};
+    }
+
+    // Objects that were removed or deactivated leave their last area damaged
+    for (auto it = renderSnapshots.begin(); it != renderSnapshots.end();) {
+        if (it->second.frame != renderFrame) {
+            damagedRects.push_back(it->second.bounds);
+            it = renderSnapshots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return boundsKnown;
+}
+
+bool Scene::MergeDamage() {
+    if (damagedRects.size() > kMaxDamageRects) {
+        return false;
+    }
+
+    const SDL_Rect screen{0, 0, retainedFrame->GetWidth(), retainedFrame->GetHeight()};
+
+    // Clip to the screen and drop empty regions
+    size_t count = 0;
+    for (const auto& rect : damagedRects) {
+        SDL_Rect clipped;
+        if (SDL_IntersectRect(&rect, &screen, &clipped)) {
+            damagedRects[count++] = clipped;
+        }
+    }
+    damagedRects.resize(count);
+
+    // Merge overlapping regions so no pixel is redrawn twice
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < damagedRects.size(); ++i) {
+            for (size_t j = i + 1; j < damagedRects.size();) {
+                if (SDL_HasIntersection(&damagedRects[i], &damagedRects[j])) {
+                    SDL_UnionRect(&damagedRects[i], &damagedRects[j], &damagedRects[i]);
+                    damagedRects[j] = damagedRects.back();
+                    damagedRects.pop_back();
+                    merged = true;
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+
+    // Redrawing most of the screen piecewise costs more than one full redraw
+    long long damagedArea = 0;
+    for (const auto& rect : damagedRects) {
+        damagedArea += static_cast<long long>(rect.w) * rect.h;
+    }
+    long long screenArea = static_cast<long long>(screen.w) * screen.h;
+    return damagedArea * 10 < screenArea * 6;
+}
+
+void Scene::SafeRenderObject(GameObject* obj) {
+    try {
+        obj->Render();
+    } catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "Error rendering object: %s", e.what());
     }
 }
 
@@ -67,6 +464,7 @@ void Scene::AddGameObject(const std::shared_ptr<GameObject>& gameObject) {
 
     gameObjects.push_back(gameObject);
     RegisterGameObjectTag(gameObject);
+    hierarchyOrderValid = false;
 }
 
 void Scene::RemoveGameObject(const std::shared_ptr<GameObject>& gameObject) {
@@ -77,6 +475,7 @@ void Scene::RemoveGameObject(const std::shared_ptr<GameObject>& gameObject) {
     auto it = std::find(gameObjects.begin(), gameObjects.end(), gameObject);
     if (it != gameObjects.end()) {
         gameObjects.erase(it);
+        hierarchyOrderValid = false;
     }
 }
 
@@ -102,6 +501,10 @@ std::shared_ptr<GameObject> Scene::GetGameObjectByTag(const std::string& tag) {
 }
 
 void Scene::CheckCollisions() {
+    PROFILE_ZONE("Scene::CheckCollisions");
+    static Metrics::Counter& pairsTested = Metrics::Instance().GetCounter("scene.collision_pairs");
+    const size_t objectCount = gameObjects.size();
+    pairsTested.Add(objectCount > 1 ? objectCount * (objectCount - 1) / 2 : 0);
     isProcessingCollisions = true;
     std::unordered_set<CollisionPair, WeakPtrPairHash, WeakPtrPairEqual> currentFrameCollisions;
 
@@ -261,8 +664,13 @@ void Scene::DrawDebugCollisions(SDL_Renderer* renderer) {
         auto second = pair.second.lock();
 
         if (first && second) {
-            const auto& pos1 = first->GetTransform().position;
-            const auto& pos2 = second->GetTransform().position;
+            Vector2D pos1 = first->GetWorldTransform().position;
+            Vector2D pos2 = second->GetWorldTransform().position;
+
+            if (const Camera* camera = Camera::GetActive()) {
+                pos1 = camera->WorldToScreen(pos1);
+                pos2 = camera->WorldToScreen(pos2);
+            }
 
             SDL_RenderDrawLine(renderer,
                 static_cast<int>(pos1.x),
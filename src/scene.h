@@ -16,10 +16,24 @@
 #include <memory>
 #include <SDL2/SDL.h>
 
+#include "animationsystem.h"
+#include "asset-manifest.h"
 #include "gameobject.h"
+#include "rendertarget.h"
+#include "tweenmanager.h"
+
+class Camera;
 
 class Scene {
 public:
+    /**
+     * @brief How often objects at a given distance from the cameras are updated
+     */
+    struct UpdateLodTier {
+        float distance;   ///< Minimum distance outside every camera view, in world units
+        Uint32 interval;  ///< Update once every this many frames
+    };
+
     Scene() = default;
     virtual ~Scene();
 
@@ -88,6 +102,118 @@ public:
      */
     bool IsDebugDrawEnabled() const { return debugDrawEnabled; }
 
+    /**
+     * @brief Add a camera to render the scene through
+     *
+     * With one or more cameras the scene is drawn once per camera, each into
+     * its own viewport with its own culling. Objects are sorted into a render
+     * queue once per frame and that queue is shared by all cameras.
+     * Without cameras, objects are drawn in screen space.
+     * @param camera Camera to add
+     */
+    void AddCamera(std::shared_ptr<Camera> camera);
+
+    /**
+     * @brief Remove a camera from the scene
+     * @param camera Camera to remove
+     */
+    void RemoveCamera(const std::shared_ptr<Camera>& camera);
+
+    /**
+     * @brief Get the cameras the scene renders through, in render order
+     * @return Cameras added to the scene
+     */
+    const std::vector<std::shared_ptr<Camera>>& GetCameras() const { return cameras; }
+
+    /**
+     * @brief Update distant objects less often
+     *
+     * Each frame an object is assigned the last tier whose distance it is
+     * beyond, measured from the nearest camera's view rectangle, unless it is
+     * pinned with GameObject::SetUpdateTier(). Skipped frames are not lost:
+     * the object's next Update() receives the time accumulated since its last
+     * one. Objects are always updated every frame in scenes without cameras.
+     * @param tiers Tiers sorted by increasing distance, e.g.
+     *        {{0, 1}, {256, 4}, {1024, 16}}; empty updates everything every frame
+     */
+    void SetUpdateLodTiers(std::vector<UpdateLodTier> tiers);
+
+    /**
+     * @brief Get the update LOD tiers
+     * @return Tiers sorted by distance, empty if update LOD is disabled
+     */
+    const std::vector<UpdateLodTier>& GetUpdateLodTiers() const { return updateLodTiers; }
+
+    /**
+     * @brief Get the number of objects updated in the last frame
+     * @return Objects whose Update() ran in the last Scene::Update()
+     */
+    size_t GetUpdatedObjectCount() const { return updatedObjectCount; }
+
+    /**
+     * @brief Render the scene into an offscreen target instead of the current one
+     * The target is cleared and drawn every frame; compositing it is up to the caller.
+     * @param target Render target to draw into, or nullptr to draw directly
+     */
+    void SetRenderTarget(std::shared_ptr<RenderTarget> target) { renderTarget = std::move(target); }
+
+    /**
+     * @brief Get the offscreen target the scene renders into
+     * @return Render target, or nullptr if the scene draws directly
+     */
+    const std::shared_ptr<RenderTarget>& GetRenderTarget() const { return renderTarget; }
+
+    /**
+     * @brief Enable or disable retained (dirty-rectangle) rendering
+     *
+     * In retained mode the scene keeps the previous frame in an offscreen
+     * texture and only redraws the regions covered by objects whose
+     * transform, sprite or presence changed since the last frame.
+     * Retained rendering only applies to scenes without cameras.
+     * @param enabled True to enable retained rendering
+     */
+    void SetRetainedRenderingEnabled(bool enabled);
+
+    /**
+     * @brief Check if retained rendering is enabled
+     * @return True if retained rendering is enabled
+     */
+    bool IsRetainedRenderingEnabled() const { return retainedRenderingEnabled; }
+
+    /**
+     * @brief Force the next retained frame to be redrawn completely
+     * Call this after changing state the scene cannot observe, such as
+     * texture contents or custom drawing in GameObject::Render overrides.
+     */
+    void InvalidateRetainedFrame() { retainedFrameValid = false; }
+
+    /**
+     * @brief Get the assets this scene needs
+     *
+     * Declare them in the constructor so Game::PreloadScene() can load them
+     * in the background before the scene starts. When a scene with a
+     * non-empty manifest becomes active, cached assets it does not list are
+     * released once nothing references them.
+     * @return The scene's asset manifest
+     */
+    AssetManifest& GetAssetManifest() { return assetManifest; }
+    const AssetManifest& GetAssetManifest() const { return assetManifest; }
+
+    /**
+     * @brief Get the animation instances of this scene
+     * They are advanced in Update() before game objects update,
+     * so objects see this frame's animation frames.
+     * @return The scene's animation system
+     */
+    AnimationSystem& GetAnimationSystem() { return animationSystem; }
+
+    /**
+     * @brief Get the tweens of this scene
+     * They are advanced in Update() before cameras and game objects update.
+     * @return The scene's tween manager
+     */
+    TweenManager& GetTweenManager() { return tweenManager; }
+
 protected:
     /**
      * @brief Called when two objects collide
@@ -133,6 +259,29 @@ private:
         }
     };
 
+    /**
+     * @brief An object queued for rendering this frame
+     */
+    struct RenderItem {
+        GameObject* object;
+        SDL_Rect bounds;       ///< World-space bounds, valid if boundsKnown
+        bool boundsKnown;
+    };
+
+    /**
+     * @brief What an object looked like when it was last drawn in retained mode
+     */
+    struct RenderSnapshot {
+        SDL_Rect bounds;          ///< Screen area covered by the object
+        Vector2D position;
+        Vector2D scale;
+        float rotation;
+        const Sprite* sprite;
+        Uint32 spriteVersion;
+        Uint32 renderVersion;
+        Uint32 frame;             ///< Last frame the object was seen
+    };
+
     /**
      * @brief Information about a tagged object
      */
@@ -149,6 +298,84 @@ private:
     // State flags
     bool isProcessingCollisions = false;  ///< Flag to prevent recursive collision processing
     bool debugDrawEnabled = false;        ///< Flag for debug visualization
+    std::shared_ptr<RenderTarget> renderTarget;  ///< Optional offscreen destination
+    std::vector<std::shared_ptr<Camera>> cameras;  ///< Views the scene is rendered through
+    std::vector<RenderItem> renderQueue;  ///< Active objects sorted by render layer
+    AssetManifest assetManifest;          ///< Assets preloaded before the scene starts
+    AnimationSystem animationSystem;      ///< Batched animation instances
+    TweenManager tweenManager;            ///< Batched property tweens
+
+    // Update LOD state
+    std::vector<UpdateLodTier> updateLodTiers;  ///< Sorted by distance, empty to disable
+    std::vector<SDL_Rect> updateViews;          ///< Camera view rectangles this frame
+    Uint32 updateStagger = 0;                   ///< Spreads objects entering a tier over its frames
+    size_t updatedObjectCount = 0;
+
+    // Transform hierarchy state
+    std::vector<GameObject*> hierarchyOrder;  ///< Objects with parents or children, parents first
+    Uint32 hierarchyGeneration = 0;           ///< GameObject hierarchy generation hierarchyOrder was built for
+    bool hierarchyOrderValid = false;         ///< False after objects were added or removed
+
+    // Retained rendering state
+    bool retainedRenderingEnabled = false;  ///< Flag for dirty-rectangle rendering
+    bool retainedFrameValid = false;        ///< False if the cached frame must be fully redrawn
+    std::unique_ptr<RenderTarget> retainedFrame;  ///< Persistent copy of the last frame
+    Uint32 renderFrame = 0;
+    std::unordered_map<const GameObject*, RenderSnapshot> renderSnapshots;
+    std::vector<SDL_Rect> damagedRects;
+
+    /**
+     * @brief Update every active object that is due this frame
+     */
+    void UpdateObjects(float deltaTime);
+
+    /**
+     * @brief Pick the update interval for an object from its tier
+     */
+    Uint32 GetUpdateInterval(const GameObject& obj) const;
+
+    /**
+     * @brief Bring world matrices up to date in one pass over the hierarchy
+     */
+    void UpdateWorldTransforms();
+
+    /**
+     * @brief Collect hierarchy members sorted by depth
+     */
+    void BuildHierarchyOrder();
+
+    /**
+     * @brief Render only the regions that changed since the last frame
+     */
+    void RenderRetained(SDL_Renderer* renderer, int width, int height);
+
+    /**
+     * @brief Render all active objects in layer order
+     */
+    void RenderObjects();
+
+    /**
+     * @brief Collect active objects into the render queue sorted by layer
+     * @param withBounds Also query each object's render bounds
+     */
+    void BuildRenderQueue(bool withBounds);
+
+    /**
+     * @brief Render the queued objects visible through a camera into its viewport
+     */
+    void RenderCamera(SDL_Renderer* renderer, const Camera& camera);
+
+    /**
+     * @brief Compare objects against their snapshots and collect damaged regions
+     * @return False if the whole frame must be redrawn
+     */
+    bool CollectDamage();
+
+    /**
+     * @brief Merge overlapping damaged regions
+     * @return False if the merged damage covers most of the screen
+     */
+    bool MergeDamage();
 
     /**
      * @brief Check for collisions between all objects
@@ -200,6 +427,11 @@ private:
      */
     void CleanupTags();
 
+    /**
+     * @brief Render a single object, logging any exception it throws
+     */
+    void SafeRenderObject(GameObject* obj);
+
     /**
      * @brief Draw debug visualization for collisions
      */
@@ -1,6 +1,9 @@
 #include "sprite.h"
 
+#include <camera.h>
+#include <debug/metrics.h>
 #include <game.h>
+#include <cmath>
 #include <utility>
 
 Sprite::Sprite(std::shared_ptr<SDL_Texture> texture, const SDL_Rect& srcRect)
@@ -18,6 +21,18 @@ Sprite::Sprite(std::shared_ptr<SDL_Texture> tex)
 
 void Sprite::Render(const Transform& transform) {
     SDL_Rect destRect = GetDestRect(transform);
+    double angle = transform.rotation;
+
+    // Project through the camera currently being rendered, if any
+    if (const Camera* camera = Camera::GetActive()) {
+        Vector2D screenPos = camera->WorldToScreen(transform.position);
+        float zoom = camera->GetZoom();
+        destRect.x = static_cast<int>(screenPos.x);
+        destRect.y = static_cast<int>(screenPos.y);
+        destRect.w = static_cast<int>(sourceRect.w * transform.scale.x * zoom);
+        destRect.h = static_cast<int>(sourceRect.h * transform.scale.y * zoom);
+        angle += camera->GetRotation();
+    }
     
     // Calculate the pivot point for rotation (center of the sprite)
     SDL_Point center = {
@@ -34,10 +49,13 @@ void Sprite::Render(const Transform& transform) {
         texture.get(),
         &sourceRect,
         &destRect,
-        transform.rotation,
+        angle,
         &center,
         SDL_FLIP_NONE
     );
+
+    static Metrics::Counter& drawCalls = Metrics::Instance().GetCounter("render.draw_calls");
+    drawCalls.Add();
 }
 
 const SDL_Rect& Sprite::GetSourceRect() const {
@@ -53,17 +71,46 @@ SDL_Rect Sprite::GetDestRect(const Transform& transform) const {
     return destRect;
 }
 
+SDL_Rect Sprite::GetBounds(const Transform& transform) const {
+    SDL_Rect destRect = GetDestRect(transform);
+
+    // Render() draws the rectangle centered on the transform position
+    destRect.x -= destRect.w / 2;
+    destRect.y -= destRect.h / 2;
+
+    if (transform.rotation == 0.0f) {
+        return destRect;
+    }
+
+    float c = std::fabs(transform.GetCos());
+    float s = std::fabs(transform.GetSin());
+    float halfW = (destRect.w * c + destRect.h * s) / 2.0f;
+    float halfH = (destRect.w * s + destRect.h * c) / 2.0f;
+    float centerX = destRect.x + destRect.w / 2;
+    float centerY = destRect.y + destRect.h / 2;
+
+    // Pad by a pixel to cover rasterization of the rotated edges
+    int left = static_cast<int>(std::floor(centerX - halfW)) - 1;
+    int top = static_cast<int>(std::floor(centerY - halfH)) - 1;
+    int right = static_cast<int>(std::ceil(centerX + halfW)) + 1;
+    int bottom = static_cast<int>(std::ceil(centerY + halfH)) + 1;
+    return {left, top, right - left, bottom - top};
+}
+
 void Sprite::SetFrame(int x, int y, int width, int height) {
     sourceRect.x = x;
     sourceRect.y = y;
     sourceRect.w = width;
     sourceRect.h = height;
+    ++version;
 }
 
 void Sprite::SetAlpha(Uint8 alpha) {
     SDL_SetTextureAlphaMod(texture.get(), alpha);
+    ++version;
 }
 
 void Sprite::SetBlendMode(SDL_BlendMode blendMode) {
     SDL_SetTextureBlendMode(texture.get(), blendMode);
+    ++version;
 }
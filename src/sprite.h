@@ -12,6 +12,8 @@ public:
     void Render(const Transform& transform);
     [[nodiscard]] const SDL_Rect& GetSourceRect() const;
     [[nodiscard]] SDL_Rect GetDestRect(const Transform& transform) const;
+    // Screen-space bounding box of everything Render() draws, including rotation
+    [[nodiscard]] SDL_Rect GetBounds(const Transform& transform) const;
     
     // Animation support
     void SetFrame(int x, int y, int width, int height);
@@ -19,8 +21,12 @@ public:
     void SetBlendMode(SDL_BlendMode blendMode);
     
     [[nodiscard]] SDL_Texture* GetTexture() const { return texture.get(); }
+
+    // Incremented whenever the sprite's appearance changes
+    [[nodiscard]] Uint32 GetVersion() const { return version; }
     
 private:
     std::shared_ptr<SDL_Texture> texture;
     SDL_Rect sourceRect;
+    Uint32 version = 0;
 };
@@ -0,0 +1,439 @@
+#include "spritesheet.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace {
+    // Just enough JSON for sprite sheet metadata; objects keep member order
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+        Type type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue* Get(std::string_view key) const {
+            for (const auto& [name, value] : members) {
+                if (name == key) return &value;
+            }
+            return nullptr;
+        }
+
+        double GetNumber(std::string_view key, double fallback = 0.0) const {
+            const JsonValue* value = Get(key);
+            return value && value->type == Type::Number ? value->number : fallback;
+        }
+
+        std::string GetString(std::string_view key) const {
+            const JsonValue* value = Get(key);
+            return value && value->type == Type::String ? value->string : std::string();
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(std::string_view text) : text(text) {}
+
+        bool Parse(JsonValue& value, std::string& error) {
+            if (!ParseValue(value, 0) || (SkipWhitespace(), pos != text.size())) {
+                error = "invalid JSON at offset " + std::to_string(pos);
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        static constexpr int kMaxDepth = 64;
+
+        void SkipWhitespace() {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' ||
+                                         text[pos] == '\n' || text[pos] == '\r')) {
+                ++pos;
+            }
+        }
+
+        bool Consume(char c) {
+            SkipWhitespace();
+            if (pos < text.size() && text[pos] == c) {
+                ++pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool ConsumeWord(std::string_view word) {
+            if (text.compare(pos, word.size(), word) != 0) return false;
+            pos += word.size();
+            return true;
+        }
+
+        bool ParseValue(JsonValue& value, int depth) {
+            if (depth > kMaxDepth) return false;
+            SkipWhitespace();
+            if (pos >= text.size()) return false;
+
+            switch (text[pos]) {
+                case '{': return ParseObject(value, depth);
+                case '[': return ParseArray(value, depth);
+                case '"':
+                    value.type = JsonValue::Type::String;
+                    return ParseString(value.string);
+                case 't':
+                    value.type = JsonValue::Type::Bool;
+                    value.boolean = true;
+                    return ConsumeWord("true");
+                case 'f':
+                    value.type = JsonValue::Type::Bool;
+                    return ConsumeWord("false");
+                case 'n':
+                    return ConsumeWord("null");
+                default:
+                    return ParseNumber(value);
+            }
+        }
+
+        bool ParseObject(JsonValue& value, int depth) {
+            value.type = JsonValue::Type::Object;
+            ++pos;
+            if (Consume('}')) return true;
+
+            do {
+                SkipWhitespace();
+                std::string key;
+                if (pos >= text.size() || text[pos] != '"' || !ParseString(key) || !Consume(':')) {
+                    return false;
+                }
+                value.members.emplace_back(std::move(key), JsonValue());
+                if (!ParseValue(value.members.back().second, depth + 1)) return false;
+            } while (Consume(','));
+
+            return Consume('}');
+        }
+
+        bool ParseArray(JsonValue& value, int depth) {
+            value.type = JsonValue::Type::Array;
+            ++pos;
+            if (Consume(']')) return true;
+
+            do {
+                value.items.emplace_back();
+                if (!ParseValue(value.items.back(), depth + 1)) return false;
+            } while (Consume(','));
+
+            return Consume(']');
+        }
+
+        bool ParseString(std::string& out) {
+            ++pos;  // Opening quote
+            while (pos < text.size()) {
+                char c = text[pos++];
+                if (c == '"') return true;
+                if (c != '\\') {
+                    out += c;
+                    continue;
+                }
+
+                if (pos >= text.size()) return false;
+                switch (text[pos++]) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        if (pos + 4 > text.size()) return false;
+                        const std::string hex(text.substr(pos, 4));
+                        char* end = nullptr;
+                        const unsigned long code = std::strtoul(hex.c_str(), &end, 16);
+                        if (end != hex.c_str() + 4) return false;
+                        pos += 4;
+
+                        // Basic multilingual plane only; enough for file and tag names
+                        if (code < 0x80) {
+                            out += static_cast<char>(code);
+                        } else if (code < 0x800) {
+                            out += static_cast<char>(0xC0 | (code >> 6));
+                            out += static_cast<char>(0x80 | (code & 0x3F));
+                        } else {
+                            out += static_cast<char>(0xE0 | (code >> 12));
+                            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            out += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            return false;
+        }
+
+        static bool IsNumberChar(char c) {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        bool ParseNumber(JsonValue& value) {
+            const size_t start = pos;
+            while (pos < text.size() && IsNumberChar(text[pos])) {
+                ++pos;
+            }
+            if (pos == start) return false;
+
+            const std::string number(text.substr(start, pos - start));
+            char* end = nullptr;
+            value.type = JsonValue::Type::Number;
+            value.number = std::strtod(number.c_str(), &end);
+            return end == number.c_str() + number.size();
+        }
+
+        std::string_view text;
+        size_t pos = 0;
+    };
+
+    std::uint16_t ReadU16(const std::uint8_t* p) {
+        return static_cast<std::uint16_t>(p[0] | p[1] << 8);
+    }
+
+    std::uint32_t ReadU32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) |
+               static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 |
+               static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    void WriteU16(std::vector<std::uint8_t>& out, std::uint16_t value) {
+        out.push_back(static_cast<std::uint8_t>(value));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+    }
+
+    void WriteU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    bool FitsU16(int value) {
+        return value >= 0 && value <= std::numeric_limits<std::uint16_t>::max();
+    }
+
+    constexpr size_t kClipHeaderSize = 8;
+    constexpr size_t kFrameSize = 12;
+
+    AnimationClip::Frame ParseFrame(const JsonValue& entry) {
+        AnimationClip::Frame frame{};
+        if (const JsonValue* rect = entry.Get("frame")) {
+            frame.sourceRect.x = static_cast<int>(rect->GetNumber("x"));
+            frame.sourceRect.y = static_cast<int>(rect->GetNumber("y"));
+            frame.sourceRect.w = static_cast<int>(rect->GetNumber("w"));
+            frame.sourceRect.h = static_cast<int>(rect->GetNumber("h"));
+        }
+        // Aseprite durations are in milliseconds
+        frame.duration = static_cast<float>(entry.GetNumber("duration", 100.0) / 1000.0);
+        return frame;
+    }
+}
+
+std::shared_ptr<SpriteSheet> SpriteSheet::FromJson(std::string_view json, std::string* error) {
+    auto fail = [error](std::string message) -> std::shared_ptr<SpriteSheet> {
+        if (error) *error = std::move(message);
+        return nullptr;
+    };
+
+    JsonValue root;
+    std::string parseError;
+    if (!JsonParser(json).Parse(root, parseError)) {
+        return fail(parseError);
+    }
+
+    const JsonValue* framesValue = root.Get("frames");
+    if (!framesValue) {
+        return fail("missing \"frames\"");
+    }
+
+    std::vector<AnimationClip::Frame> frames;
+    if (framesValue->type == JsonValue::Type::Array) {
+        for (const auto& entry : framesValue->items) {
+            frames.push_back(ParseFrame(entry));
+        }
+    } else if (framesValue->type == JsonValue::Type::Object) {
+        for (const auto& [name, entry] : framesValue->members) {
+            frames.push_back(ParseFrame(entry));
+        }
+    } else {
+        return fail("\"frames\" is neither an array nor an object");
+    }
+
+    auto sheet = std::make_shared<SpriteSheet>();
+    const JsonValue* meta = root.Get("meta");
+    if (meta) {
+        sheet->imagePath = meta->GetString("image");
+    }
+
+    const JsonValue* tags = meta ? meta->Get("frameTags") : nullptr;
+    if (!tags || tags->type != JsonValue::Type::Array || tags->items.empty()) {
+        AnimationClip clip;
+        clip.name = "default";
+        clip.frames = std::move(frames);
+        sheet->AddClip(std::move(clip));
+        return sheet;
+    }
+
+    for (const auto& tag : tags->items) {
+        const int from = static_cast<int>(tag.GetNumber("from", -1));
+        const int to = static_cast<int>(tag.GetNumber("to", -1));
+        if (from < 0 || to < from || static_cast<size_t>(to) >= frames.size()) {
+            return fail("frame tag '" + tag.GetString("name") + "' is out of range");
+        }
+
+        AnimationClip clip;
+        clip.name = tag.GetString("name");
+
+        // Aseprite writes repeat counts as strings; no count means forever
+        const std::string repeat = tag.GetString("repeat");
+        clip.looping = repeat.empty() || repeat == "0";
+
+        // Expand playback directions so clips always play front to back
+        const std::string direction = tag.GetString("direction");
+        std::vector<int> order;
+        for (int i = from; i <= to; ++i) order.push_back(i);
+        if (direction == "reverse" || direction == "pingpong_reverse") {
+            std::reverse(order.begin(), order.end());
+        }
+        if (direction == "pingpong" || direction == "pingpong_reverse") {
+            for (int i = static_cast<int>(order.size()) - 2; i > 0; --i) {
+                order.push_back(order[i]);
+            }
+        }
+
+        for (int index : order) {
+            clip.frames.push_back(frames[index]);
+        }
+        sheet->AddClip(std::move(clip));
+    }
+
+    return sheet;
+}
+
+std::shared_ptr<SpriteSheet> SpriteSheet::FromBinary(const void* data, size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    if (size < kHeaderSize || std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0 ||
+        ReadU32(bytes + 4) != kVersion) {
+        return nullptr;
+    }
+
+    const std::uint32_t clipCount = ReadU32(bytes + 8);
+    const std::uint32_t imagePathLength = ReadU32(bytes + 12);
+    size_t offset = kHeaderSize;
+    if (imagePathLength > size - offset) return nullptr;
+
+    auto sheet = std::make_shared<SpriteSheet>();
+    sheet->imagePath.assign(reinterpret_cast<const char*>(bytes + offset), imagePathLength);
+    offset += imagePathLength;
+
+    for (std::uint32_t c = 0; c < clipCount; ++c) {
+        if (size - offset < kClipHeaderSize) return nullptr;
+        const std::uint16_t nameLength = ReadU16(bytes + offset);
+        const std::uint16_t flags = ReadU16(bytes + offset + 2);
+        const std::uint32_t frameCount = ReadU32(bytes + offset + 4);
+        offset += kClipHeaderSize;
+
+        if (nameLength > size - offset || frameCount > (size - offset - nameLength) / kFrameSize) {
+            return nullptr;
+        }
+
+        AnimationClip clip;
+        clip.name.assign(reinterpret_cast<const char*>(bytes + offset), nameLength);
+        clip.looping = (flags & 1) != 0;
+        offset += nameLength;
+
+        clip.frames.resize(frameCount);
+        for (auto& frame : clip.frames) {
+            const std::uint8_t* p = bytes + offset;
+            frame.sourceRect = {ReadU16(p), ReadU16(p + 2), ReadU16(p + 4), ReadU16(p + 6)};
+            const std::uint32_t durationBits = ReadU32(p + 8);
+            std::memcpy(&frame.duration, &durationBits, sizeof(frame.duration));
+            offset += kFrameSize;
+        }
+
+        sheet->AddClip(std::move(clip));
+    }
+
+    return offset == size ? sheet : nullptr;
+}
+
+std::shared_ptr<SpriteSheet> SpriteSheet::FromMemory(const void* data, size_t size, std::string* error) {
+    if (size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0) {
+        auto sheet = FromBinary(data, size);
+        if (!sheet && error) *error = "malformed binary sprite sheet";
+        return sheet;
+    }
+    return FromJson(std::string_view(static_cast<const char*>(data), size), error);
+}
+
+std::vector<std::uint8_t> SpriteSheet::ToBinary() const {
+    std::vector<std::uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+    out.reserve(GetByteSize());
+    WriteU32(out, kVersion);
+    WriteU32(out, static_cast<std::uint32_t>(clips.size()));
+    WriteU32(out, static_cast<std::uint32_t>(imagePath.size()));
+    out.insert(out.end(), imagePath.begin(), imagePath.end());
+
+    for (const auto& clip : clips) {
+        if (clip->name.size() > std::numeric_limits<std::uint16_t>::max()) return {};
+
+        WriteU16(out, static_cast<std::uint16_t>(clip->name.size()));
+        WriteU16(out, clip->looping ? 1 : 0);
+        WriteU32(out, static_cast<std::uint32_t>(clip->frames.size()));
+        out.insert(out.end(), clip->name.begin(), clip->name.end());
+
+        for (const auto& frame : clip->frames) {
+            const SDL_Rect& rect = frame.sourceRect;
+            if (!FitsU16(rect.x) || !FitsU16(rect.y) || !FitsU16(rect.w) || !FitsU16(rect.h)) {
+                return {};
+            }
+            WriteU16(out, static_cast<std::uint16_t>(rect.x));
+            WriteU16(out, static_cast<std::uint16_t>(rect.y));
+            WriteU16(out, static_cast<std::uint16_t>(rect.w));
+            WriteU16(out, static_cast<std::uint16_t>(rect.h));
+
+            std::uint32_t durationBits = 0;
+            std::memcpy(&durationBits, &frame.duration, sizeof(durationBits));
+            WriteU32(out, durationBits);
+        }
+    }
+
+    return out;
+}
+
+SpriteSheet::ClipId SpriteSheet::FindClip(std::string_view name) const {
+    auto it = clipIds.find(std::string(name));
+    return it != clipIds.end() ? it->second : kInvalidClip;
+}
+
+std::shared_ptr<const AnimationClip> SpriteSheet::GetClip(ClipId id) const {
+    return id >= 0 && static_cast<size_t>(id) < clips.size() ? clips[id] : nullptr;
+}
+
+size_t SpriteSheet::GetByteSize() const {
+    size_t bytes = kHeaderSize + imagePath.size();
+    for (const auto& clip : clips) {
+        bytes += kClipHeaderSize + clip->name.size() + clip->frames.size() * kFrameSize;
+    }
+    return bytes;
+}
+
+SpriteSheet::ClipId SpriteSheet::AddClip(AnimationClip clip) {
+    const auto id = static_cast<ClipId>(clips.size());
+    clip.BuildTimeline();
+    clipIds.emplace(clip.name, id);
+    clips.push_back(std::make_shared<const AnimationClip>(std::move(clip)));
+    return id;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file spritesheet.h
+ * @brief Sprite sheet metadata with named animation clips
+ *
+ * Sheets are read from the JSON that Aseprite exports (both the "hash" and
+ * "array" frame layouts; frame tags become clips) or from a compact binary
+ * form produced by ToBinary() or the gfsheet tool, which loads without any
+ * text parsing. Clips are immutable and shared: every Animation created
+ * from a sheet references the same frame data.
+ *
+ * Binary layout (little-endian):
+ * - Header: magic "GFSH", version, clip count, image path length (16 bytes)
+ * - Image path
+ * - Per clip: name length (u16), flags (u16, bit 0 = looping), frame count
+ *   (u32), name, then per frame x, y, w, h (u16 each) and duration (f32)
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "animation.h"
+
+class SpriteSheet {
+public:
+    using ClipId = int;
+    static constexpr ClipId kInvalidClip = -1;
+
+    /**
+     * @brief Parse Aseprite JSON
+     * Without frame tags, all frames form one looping clip named "default".
+     * @param json JSON text
+     * @param error Receives a description of the problem on failure
+     * @return The sheet, or nullptr if the JSON is malformed
+     */
+    static std::shared_ptr<SpriteSheet> FromJson(std::string_view json, std::string* error = nullptr);
+
+    /**
+     * @brief Read the binary form
+     * @return The sheet, or nullptr if the data is malformed
+     */
+    static std::shared_ptr<SpriteSheet> FromBinary(const void* data, size_t size);
+
+    /**
+     * @brief Read either form, telling them apart by the binary magic
+     */
+    static std::shared_ptr<SpriteSheet> FromMemory(const void* data, size_t size, std::string* error = nullptr);
+
+    /**
+     * @brief Encode the sheet in the binary form
+     * @return Encoded bytes, or an empty vector if a frame does not fit the format
+     */
+    [[nodiscard]] std::vector<std::uint8_t> ToBinary() const;
+
+    /**
+     * @brief Look up a clip by name
+     * @return Clip id, or kInvalidClip if there is no such clip
+     */
+    [[nodiscard]] ClipId FindClip(std::string_view name) const;
+
+    /**
+     * @brief Get a clip by id
+     * @return The clip, or nullptr for an invalid id
+     */
+    [[nodiscard]] std::shared_ptr<const AnimationClip> GetClip(ClipId id) const;
+
+    // Clips in id order, for AnimationController::AddClips()
+    [[nodiscard]] const std::vector<std::shared_ptr<const AnimationClip>>& GetClips() const { return clips; }
+
+    // Image file named by the sheet, relative to the sheet as exported
+    [[nodiscard]] const std::string& GetImagePath() const { return imagePath; }
+
+    // Approximate memory used by the frame data
+    [[nodiscard]] size_t GetByteSize() const;
+
+    void SetImagePath(std::string path) { imagePath = std::move(path); }
+    ClipId AddClip(AnimationClip clip);
+
+    static constexpr char kMagic[4] = {'G', 'F', 'S', 'H'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 16;
+
+private:
+    std::string imagePath;
+    std::vector<std::shared_ptr<const AnimationClip>> clips;
+    std::unordered_map<std::string, ClipId> clipIds;
+};
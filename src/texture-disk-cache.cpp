@@ -0,0 +1,163 @@
+#include "texture-disk-cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace {
+    std::uint32_t ReadU32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) |
+               static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 |
+               static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    std::uint64_t ReadU64(const std::uint8_t* p) {
+        return static_cast<std::uint64_t>(ReadU32(p)) |
+               static_cast<std::uint64_t>(ReadU32(p + 4)) << 32;
+    }
+
+    void WriteU32(std::uint8_t* p, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            p[i] = static_cast<std::uint8_t>(value >> (i * 8));
+        }
+    }
+
+    void WriteU64(std::uint8_t* p, std::uint64_t value) {
+        WriteU32(p, static_cast<std::uint32_t>(value));
+        WriteU32(p + 4, static_cast<std::uint32_t>(value >> 32));
+    }
+
+    size_t PixelOffset(size_t pathLength) {
+        return (TextureDiskCache::kHeaderSize + pathLength + 15) / 16 * 16;
+    }
+}
+
+bool TextureDiskCache::SetDirectory(const std::string& path) {
+    directory.clear();
+    if (path.empty()) {
+        return true;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(path, error);
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "Failed to create texture cache directory '%s': %s", path.c_str(), error.message().c_str());
+        return false;
+    }
+
+    directory = path;
+    return true;
+}
+
+std::string TextureDiskCache::GetCacheFile(const std::string& sourcePath) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.gftx",
+                  static_cast<unsigned long long>(Hash(sourcePath.data(), sourcePath.size())));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool TextureDiskCache::Load(const std::string& sourcePath, std::uint64_t stamp, Image& image) const {
+    if (!IsEnabled()) return false;
+
+    std::ifstream in(GetCacheFile(sourcePath), std::ios::binary | std::ios::ate);
+    if (!in) return false;
+
+    const std::streamoff fileSize = in.tellg();
+    if (fileSize < static_cast<std::streamoff>(kHeaderSize)) return false;
+
+    // One read for header, path and pixels
+    image.data.resize(static_cast<size_t>(fileSize));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(image.data.data()), fileSize)) return false;
+
+    const std::uint8_t* header = image.data.data();
+    if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0 || ReadU32(header + 4) != kVersion) {
+        return false;
+    }
+
+    const std::uint32_t width = ReadU32(header + 8);
+    const std::uint32_t height = ReadU32(header + 12);
+    const std::uint64_t storedStamp = ReadU64(header + 16);
+    const std::uint32_t pathLength = ReadU32(header + 24);
+
+    if (storedStamp != stamp || pathLength != sourcePath.size() ||
+        kHeaderSize + pathLength > image.data.size() ||
+        std::memcmp(header + kHeaderSize, sourcePath.data(), pathLength) != 0) {
+        return false;
+    }
+
+    const size_t offset = PixelOffset(pathLength);
+    if (width == 0 || height == 0 || width > 16384 || height > 16384 ||
+        offset + static_cast<size_t>(width) * height * 4 != image.data.size()) {
+        return false;
+    }
+
+    image.pixelOffset = offset;
+    image.width = static_cast<int>(width);
+    image.height = static_cast<int>(height);
+    return true;
+}
+
+bool TextureDiskCache::Store(const std::string& sourcePath, std::uint64_t stamp, SDL_Surface* surface) const {
+    if (!IsEnabled() || !surface) return false;
+
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) return false;
+
+    const size_t offset = PixelOffset(sourcePath.size());
+    const size_t rowBytes = static_cast<size_t>(rgba->w) * 4;
+    std::vector<std::uint8_t> file(offset + rowBytes * rgba->h, 0);
+
+    std::memcpy(file.data(), kMagic, sizeof(kMagic));
+    WriteU32(file.data() + 4, kVersion);
+    WriteU32(file.data() + 8, static_cast<std::uint32_t>(rgba->w));
+    WriteU32(file.data() + 12, static_cast<std::uint32_t>(rgba->h));
+    WriteU64(file.data() + 16, stamp);
+    WriteU32(file.data() + 24, static_cast<std::uint32_t>(sourcePath.size()));
+    std::memcpy(file.data() + kHeaderSize, sourcePath.data(), sourcePath.size());
+
+    // Surface rows may be padded; the cache stores them tightly packed
+    SDL_LockSurface(rgba);
+    const auto* pixels = static_cast<const std::uint8_t*>(rgba->pixels);
+    for (int y = 0; y < rgba->h; ++y) {
+        std::memcpy(file.data() + offset + y * rowBytes, pixels + y * rgba->pitch, rowBytes);
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+
+    // Write under a temporary name so readers never see a partial file
+    const std::string target = GetCacheFile(sourcePath);
+    const std::string temporary = target + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()))) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t TextureDiskCache::Hash(const void* data, size_t size, std::uint64_t seed) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file texture-disk-cache.h
+ * @brief On-disk cache of decoded RGBA texture pixels
+ *
+ * Decoding PNG/JPG files is far slower than reading raw pixels, so decoded
+ * images are stored as RGBA32 in one file per source path. A cache file is
+ * only used while the stamp of its source (modification time and size)
+ * matches the stamp it was written with; otherwise it is rewritten.
+ *
+ * File layout (little-endian):
+ * - Header: magic "GFTX", version, width, height, source stamp,
+ *   source path length, reserved (32 bytes)
+ * - Source path, used to detect hash collisions
+ * - Padding to a 16-byte boundary, then width * height * 4 bytes of pixels
+ */
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TextureDiskCache {
+public:
+    // Pixels read back from a cache file
+    struct Image {
+        std::vector<std::uint8_t> data;  ///< Whole cache file, read in one call
+        size_t pixelOffset = 0;
+        int width = 0;
+        int height = 0;
+
+        [[nodiscard]] const void* GetPixels() const { return data.data() + pixelOffset; }
+        [[nodiscard]] int GetPitch() const { return width * 4; }
+    };
+
+    /**
+     * @brief Set where cache files are stored, creating the directory if needed
+     * Call before loading textures; an empty path disables the cache.
+     * @param path Cache directory
+     * @return False if the directory cannot be created (the cache stays disabled)
+     */
+    bool SetDirectory(const std::string& path);
+
+    [[nodiscard]] const std::string& GetDirectory() const { return directory; }
+    [[nodiscard]] bool IsEnabled() const { return !directory.empty(); }
+
+    /**
+     * @brief Read cached pixels for a source asset
+     * Safe to call from worker threads.
+     * @param sourcePath Path the texture was loaded from
+     * @param stamp Current stamp of the source
+     * @param image Receives the pixels
+     * @return False on a miss or a stale or corrupt cache file
+     */
+    bool Load(const std::string& sourcePath, std::uint64_t stamp, Image& image) const;
+
+    /**
+     * @brief Write a decoded surface to the cache
+     * Safe to call from worker threads.
+     * @param sourcePath Path the texture was loaded from
+     * @param stamp Current stamp of the source
+     * @param surface Decoded image in any pixel format
+     * @return False if the file cannot be written
+     */
+    bool Store(const std::string& sourcePath, std::uint64_t stamp, SDL_Surface* surface) const;
+
+    /**
+     * @brief Get the cache file used for a source path
+     */
+    [[nodiscard]] std::string GetCacheFile(const std::string& sourcePath) const;
+
+    /**
+     * @brief 64-bit FNV-1a hash, used for cache file names and source stamps
+     */
+    static std::uint64_t Hash(const void* data, size_t size, std::uint64_t seed = 14695981039346656037ull);
+
+    static constexpr char kMagic[4] = {'G', 'F', 'T', 'X'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 32;
+
+private:
+    std::string directory;
+};
@@ -0,0 +1,47 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include "debug/profiler.h"
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threadCount = std::max(1u, hardware > 1 ? hardware - 1 : 1u);
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    PROFILE_THREAD("ThreadPool worker");
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+            // Drain the queue before exiting so no submitted future is left broken
+            if (jobs.empty()) return;
+
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+        PROFILE_ZONE("ThreadPool::Job");
+        job();
+    }
+}
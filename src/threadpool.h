@@ -0,0 +1,73 @@
+/**
+ * @file threadpool.h
+ * @brief Fixed-size pool of worker threads for background jobs
+ *
+ * Jobs are run in submission order by whichever worker is free. The pool is
+ * meant for blocking work that must stay off the main thread, such as file
+ * IO and image decoding. Anything touching the renderer must not run here.
+ */
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * @brief Start the worker threads
+     * @param threadCount Number of workers, or 0 to use one less than the
+     *        number of hardware threads (at least one)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Finish all queued jobs and join the workers
+     */
+    ~ThreadPool();
+
+    // Prevent copying and assignment
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a job for a worker thread
+     * @param job Callable taking no arguments
+     * @return Future for the job's result; exceptions thrown by the job are
+     *         rethrown from get()
+     */
+    template<typename F>
+    std::future<std::invoke_result_t<F>> Submit(F&& job) {
+        using Result = std::invoke_result_t<F>;
+
+        // std::function needs a copyable target, so the task is shared
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    [[nodiscard]] size_t GetThreadCount() const { return workers.size(); }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
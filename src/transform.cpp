@@ -20,11 +20,58 @@ void Transform::SetScale(const Vector2D& newScale) {
 }
 
 Vector2D Transform::GetForward() const {
-    float radians = rotation * (M_PI / 180.0f);
-    return Vector2D(std::cos(radians), std::sin(radians));
+    UpdateTrig();
+    return Vector2D(cachedCos, cachedSin);
 }
 
 Vector2D Transform::GetRight() const {
-    float radians = (rotation + 90.0f) * (M_PI / 180.0f);
-    return Vector2D(std::cos(radians), std::sin(radians));
+    // Forward rotated by 90 degrees
+    UpdateTrig();
+    return Vector2D(-cachedSin, cachedCos);
+}
+
+const Matrix2D& Transform::GetMatrix() const {
+    if (!matrixValid || position != matrixPosition || scale != matrixScale ||
+        rotation != matrixRotation) {
+        UpdateTrig();
+        cachedMatrix = Matrix2D::FromTRS(position, cachedSin, cachedCos, scale);
+        matrixPosition = position;
+        matrixScale = scale;
+        matrixRotation = rotation;
+        matrixValid = true;
+        matrixVersion = ++nextMatrixVersion;
+    }
+    return cachedMatrix;
+}
+
+Transform Transform::FromMatrix(const Matrix2D& matrix) {
+    Transform result;
+
+    float scaleX = std::sqrt(matrix.a * matrix.a + matrix.b * matrix.b);
+    if (scaleX > 0.0f) {
+        result.cachedCos = matrix.a / scaleX;
+        result.cachedSin = matrix.b / scaleX;
+        result.rotation = std::atan2(matrix.b, matrix.a) * (180.0f / M_PI);
+        result.scale = Vector2D(scaleX, (matrix.a * matrix.d - matrix.b * matrix.c) / scaleX);
+    } else {
+        result.scale = Vector2D(0.0f, std::sqrt(matrix.c * matrix.c + matrix.d * matrix.d));
+    }
+    result.position = Vector2D(matrix.tx, matrix.ty);
+    result.cachedRotation = result.rotation;
+
+    // Keep the exact matrix so skewed hierarchies still collide correctly
+    result.cachedMatrix = matrix;
+    result.matrixPosition = result.position;
+    result.matrixScale = result.scale;
+    result.matrixRotation = result.rotation;
+    result.matrixValid = true;
+    result.matrixVersion = ++nextMatrixVersion;
+    return result;
+}
+
+void Transform::RecomputeTrig() const {
+    float radians = rotation * (M_PI / 180.0f);
+    cachedSin = std::sin(radians);
+    cachedCos = std::cos(radians);
+    cachedRotation = rotation;
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "vector2d.h"
+#include "matrix2d.h"
 
 class Transform {
 public:
@@ -19,7 +20,48 @@ public:
     // Get forward and right vectors based on rotation
     Vector2D GetForward() const;
     Vector2D GetRight() const;
+
+    // Sine and cosine of the rotation, recomputed only when rotation changes
+    float GetSin() const { UpdateTrig(); return cachedSin; }
+    float GetCos() const { UpdateTrig(); return cachedCos; }
+
+    // Local-to-world matrix (scale, then rotate, then translate)
+    const Matrix2D& GetMatrix() const;
+
+    // Changes whenever GetMatrix() would return a new matrix. Versions are
+    // drawn from a shared counter, so equal versions mean equal matrices
+    // even across copied transforms.
+    unsigned int GetMatrixVersion() const { GetMatrix(); return matrixVersion; }
+
+    // Decompose an affine matrix into position, rotation and scale.
+    // Skew cannot be represented by the fields, but GetMatrix() on the
+    // result returns the original matrix until a field is changed.
+    static Transform FromMatrix(const Matrix2D& matrix);
     
     // Get position
     const Vector2D& GetPosition() const { return position; }
+
+private:
+    // The fields above are public and written directly, so cached values
+    // remember the inputs they were computed from instead of relying on
+    // setters to raise a dirty flag.
+    void UpdateTrig() const {
+        if (rotation != cachedRotation) {
+            RecomputeTrig();
+        }
+    }
+    void RecomputeTrig() const;
+
+    mutable float cachedRotation = 0.0f;
+    mutable float cachedSin = 0.0f;
+    mutable float cachedCos = 1.0f;
+
+    mutable Matrix2D cachedMatrix;
+    mutable Vector2D matrixPosition;
+    mutable Vector2D matrixScale;
+    mutable float matrixRotation = 0.0f;
+    mutable bool matrixValid = false;
+    mutable unsigned int matrixVersion = 0;
+
+    static inline unsigned int nextMatrixVersion = 0;
 };
@@ -0,0 +1,284 @@
+#include "tweenmanager.h"
+#include <algorithm>
+#include <cmath>
+#include "camera.h"
+#include "ui/ui_text.h"
+
+namespace {
+    constexpr float kPi = 3.14159265f;
+
+    float BounceOut(float t) {
+        if (t < 1.0f / 2.75f) return 7.5625f * t * t;
+        if (t < 2.0f / 2.75f) { t -= 1.5f / 2.75f; return 7.5625f * t * t + 0.75f; }
+        if (t < 2.5f / 2.75f) { t -= 2.25f / 2.75f; return 7.5625f * t * t + 0.9375f; }
+        t -= 2.625f / 2.75f;
+        return 7.5625f * t * t + 0.984375f;
+    }
+
+    std::array<float, 4> Pack(float value) { return {value, 0.0f, 0.0f, 0.0f}; }
+    std::array<float, 4> Pack(const Vector2D& value) { return {value.x, value.y, 0.0f, 0.0f}; }
+    std::array<float, 4> Pack(const SDL_Color& value) {
+        return {static_cast<float>(value.r), static_cast<float>(value.g),
+                static_cast<float>(value.b), static_cast<float>(value.a)};
+    }
+
+    SDL_Color ToColor(const float* v) {
+        auto channel = [](float c) { return static_cast<Uint8>(std::clamp(std::lround(c), 0L, 255L)); };
+        return {channel(v[0]), channel(v[1]), channel(v[2]), channel(v[3])};
+    }
+}
+
+float TweenManager::Evaluate(Ease ease, float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    constexpr float back = 1.70158f;
+
+    switch (ease) {
+        case Ease::Linear: return t;
+        case Ease::QuadIn: return t * t;
+        case Ease::QuadOut: return t * (2.0f - t);
+        case Ease::QuadInOut: return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+        case Ease::CubicIn: return t * t * t;
+        case Ease::CubicOut: { const float u = 1.0f - t; return 1.0f - u * u * u; }
+        case Ease::CubicInOut: {
+            if (t < 0.5f) return 4.0f * t * t * t;
+            const float u = 1.0f - t;
+            return 1.0f - 4.0f * u * u * u;
+        }
+        case Ease::SineIn: return 1.0f - std::cos(t * kPi / 2.0f);
+        case Ease::SineOut: return std::sin(t * kPi / 2.0f);
+        case Ease::SineInOut: return 0.5f - 0.5f * std::cos(t * kPi);
+        case Ease::ExpoOut: return t >= 1.0f ? 1.0f : 1.0f - std::pow(2.0f, -10.0f * t);
+        case Ease::BackIn: return t * t * ((back + 1.0f) * t - back);
+        case Ease::BackOut: {
+            const float u = t - 1.0f;
+            return 1.0f + u * u * ((back + 1.0f) * u + back);
+        }
+        case Ease::ElasticOut: {
+            if (t <= 0.0f || t >= 1.0f) return t;
+            return std::pow(2.0f, -10.0f * t) * std::sin((t * 10.0f - 0.75f) * (2.0f * kPi / 3.0f)) + 1.0f;
+        }
+        case Ease::BounceOut: return BounceOut(t);
+    }
+    return t;
+}
+
+TweenManager::Handle TweenManager::To(float* value, float to, float duration, Ease ease) {
+    return Start(Property::Float, value, Pack(*value), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::To(Vector2D* value, const Vector2D& to, float duration, Ease ease) {
+    return Start(Property::Vector, value, Pack(*value), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::To(SDL_Color* value, const SDL_Color& to, float duration, Ease ease) {
+    return Start(Property::Color, value, Pack(*value), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::To(float from, float to, float duration, std::function<void(float)> apply,
+                                      Ease ease) {
+    const Handle handle = Start(Property::Custom, nullptr, Pack(from), Pack(to), duration, ease);
+    callbacks.back().apply = std::move(apply);
+    return handle;
+}
+
+TweenManager::Handle TweenManager::MoveTo(Camera& camera, const Vector2D& to, float duration, Ease ease) {
+    return Start(Property::CameraPosition, &camera, Pack(camera.GetPosition()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::ZoomTo(Camera& camera, float to, float duration, Ease ease) {
+    return Start(Property::CameraZoom, &camera, Pack(camera.GetZoom()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::RotateTo(Camera& camera, float degrees, float duration, Ease ease) {
+    return Start(Property::CameraRotation, &camera, Pack(camera.GetRotation()), Pack(degrees), duration, ease);
+}
+
+TweenManager::Handle TweenManager::MoveTo(UIElement& element, const Vector2D& to, float duration, Ease ease) {
+    return Start(Property::UIPosition, &element, Pack(element.GetPosition()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::ResizeTo(UIElement& element, const Vector2D& to, float duration, Ease ease) {
+    return Start(Property::UISize, &element, Pack(element.GetSize()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::ScaleTo(UIElement& element, const Vector2D& to, float duration, Ease ease) {
+    return Start(Property::UIScale, &element, Pack(element.GetScale()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::ColorTo(UIText& text, const SDL_Color& to, float duration, Ease ease) {
+    // Upcast so KillTweensOf() matches the pointer callers pass as a UIElement
+    UIElement* element = &text;
+    return Start(Property::UITextColor, element, Pack(text.GetColor()), Pack(to), duration, ease);
+}
+
+TweenManager::Handle TweenManager::Start(Property property, void* target, const std::array<float, 4>& from,
+                                         const std::array<float, 4>& to, float duration, Ease ease) {
+    std::uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(sparse.size());
+        sparse.push_back(kFreeSlot);
+        generations.push_back(0);
+    }
+    const Handle handle = slot | (static_cast<Handle>(generations[slot]) << kSlotBits);
+
+    Tween tween;
+    tween.target = target;
+    tween.from = from;
+    tween.to = to;
+    tween.duration = std::max(duration, 0.0f);
+    tween.property = property;
+    tween.ease = ease;
+
+    sparse[slot] = static_cast<std::uint32_t>(tweens.size());
+    tweens.push_back(tween);
+    callbacks.emplace_back();
+    denseHandles.push_back(handle);
+    return handle;
+}
+
+std::uint32_t TweenManager::Find(Handle handle) const {
+    const std::uint32_t slot = handle & kSlotMask;
+    if (slot >= sparse.size() || generations[slot] != (handle >> kSlotBits)) {
+        return kFreeSlot;
+    }
+    return sparse[slot];
+}
+
+void TweenManager::SetDelay(Handle handle, float delay) {
+    const std::uint32_t index = Find(handle);
+    if (index != kFreeSlot) {
+        tweens[index].elapsed = -std::max(delay, 0.0f);
+    }
+}
+
+void TweenManager::SetRepeat(Handle handle, int count, bool yoyo) {
+    const std::uint32_t index = Find(handle);
+    if (index != kFreeSlot) {
+        tweens[index].repeat = std::max(count, -1);
+        tweens[index].yoyo = yoyo;
+    }
+}
+
+void TweenManager::OnComplete(Handle handle, std::function<void()> callback) {
+    const std::uint32_t index = Find(handle);
+    if (index != kFreeSlot) {
+        callbacks[index].onComplete = std::move(callback);
+    }
+}
+
+void TweenManager::Kill(Handle handle, bool complete) {
+    const std::uint32_t index = Find(handle);
+    if (index == kFreeSlot) return;
+
+    if (!complete) {
+        Remove(index);
+        return;
+    }
+
+    Apply(index, 1.0f);
+    auto onComplete = std::move(callbacks[index].onComplete);
+    Remove(index);
+    if (onComplete) onComplete();
+}
+
+void TweenManager::KillTweensOf(const void* target) {
+    if (!target) return;
+
+    for (size_t i = tweens.size(); i-- > 0;) {
+        if (tweens[i].target == target) {
+            Remove(i);
+        }
+    }
+}
+
+void TweenManager::Update(float deltaTime) {
+    for (size_t i = 0; i < tweens.size(); ++i) {
+        Tween& tween = tweens[i];
+        tween.elapsed += deltaTime;
+        if (tween.elapsed < 0.0f) continue;
+
+        if (tween.elapsed < tween.duration) {
+            Apply(i, tween.elapsed / tween.duration);
+            continue;
+        }
+
+        if (tween.repeat == 0) {
+            Apply(i, 1.0f);
+            finished.push_back(denseHandles[i]);
+            continue;
+        }
+
+        // Start the next run, keeping the time past the end
+        tween.elapsed = tween.duration > 0.0f ? std::fmod(tween.elapsed, tween.duration) : 0.0f;
+        if (tween.repeat > 0) --tween.repeat;
+        if (tween.yoyo) std::swap(tween.from, tween.to);
+        Apply(i, tween.duration > 0.0f ? tween.elapsed / tween.duration : 0.0f);
+    }
+
+    // Remove finished tweens after the pass, so their callbacks may start or kill tweens
+    for (Handle handle : finished) {
+        const std::uint32_t index = Find(handle);
+        if (index == kFreeSlot) continue;
+
+        auto onComplete = std::move(callbacks[index].onComplete);
+        Remove(index);
+        if (onComplete) onComplete();
+    }
+    finished.clear();
+}
+
+void TweenManager::Apply(size_t index, float t) {
+    const Tween& tween = tweens[index];
+    const float e = Evaluate(tween.ease, t);
+
+    float v[4];
+    for (int c = 0; c < 4; ++c) {
+        v[c] = tween.from[c] + (tween.to[c] - tween.from[c]) * e;
+    }
+
+    switch (tween.property) {
+        case Property::Float: *static_cast<float*>(tween.target) = v[0]; break;
+        case Property::Vector: *static_cast<Vector2D*>(tween.target) = Vector2D(v[0], v[1]); break;
+        case Property::Color: *static_cast<SDL_Color*>(tween.target) = ToColor(v); break;
+        case Property::Custom: callbacks[index].apply(v[0]); break;
+        case Property::CameraPosition: static_cast<Camera*>(tween.target)->SetPosition(Vector2D(v[0], v[1])); break;
+        case Property::CameraZoom: static_cast<Camera*>(tween.target)->SetZoom(v[0]); break;
+        case Property::CameraRotation: static_cast<Camera*>(tween.target)->SetRotation(v[0]); break;
+        case Property::UIPosition: static_cast<UIElement*>(tween.target)->SetPosition(Vector2D(v[0], v[1])); break;
+        case Property::UISize: static_cast<UIElement*>(tween.target)->SetSize(Vector2D(v[0], v[1])); break;
+        case Property::UIScale: static_cast<UIElement*>(tween.target)->SetScale(Vector2D(v[0], v[1])); break;
+        case Property::UITextColor:
+            static_cast<UIText*>(static_cast<UIElement*>(tween.target))->SetColor(ToColor(v));
+            break;
+    }
+}
+
+void TweenManager::Remove(size_t index) {
+    const Handle handle = denseHandles[index];
+    const std::uint32_t slot = handle & kSlotMask;
+
+    // Move the last tween into the hole to keep the arrays dense
+    const size_t last = tweens.size() - 1;
+    if (index != last) {
+        tweens[index] = tweens[last];
+        callbacks[index] = std::move(callbacks[last]);
+        denseHandles[index] = denseHandles[last];
+        sparse[denseHandles[index] & kSlotMask] = static_cast<std::uint32_t>(index);
+    }
+    tweens.pop_back();
+    callbacks.pop_back();
+    denseHandles.pop_back();
+
+    sparse[slot] = kFreeSlot;
+    ++generations[slot];
+    freeSlots.push_back(slot);
+}
+
+void TweenManager::Clear() {
+    while (!tweens.empty()) {
+        Remove(tweens.size() - 1);
+    }
+}
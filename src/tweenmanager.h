@@ -0,0 +1,192 @@
+/**
+ * @file tweenmanager.h
+ * @brief Batched property tweens with easing curves
+ *
+ * A TweenManager interpolates floats, vectors and colors from their current
+ * value to a target over time. Active tweens are plain records in one dense
+ * array, updated in a single pass per frame; finished tweens are swapped out
+ * so the array never has holes. Tweens are addressed by handles that carry a
+ * generation, so a handle of a finished tween never matches a newer tween
+ * that reuses its slot.
+ *
+ * Tweens keep raw pointers to their targets. Call KillTweensOf() on a target
+ * before destroying it.
+ */
+#pragma once
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "vector2d.h"
+
+class Camera;
+class UIElement;
+class UIText;
+
+/**
+ * @brief Easing curves mapping linear progress in [0, 1] to eased progress
+ */
+enum class Ease : std::uint8_t {
+    Linear,
+    QuadIn,
+    QuadOut,
+    QuadInOut,
+    CubicIn,
+    CubicOut,
+    CubicInOut,
+    SineIn,
+    SineOut,
+    SineInOut,
+    ExpoOut,
+    BackIn,
+    BackOut,
+    ElasticOut,
+    BounceOut
+};
+
+class TweenManager {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle kInvalidHandle = 0xFFFFFFFFu;
+
+    /**
+     * @brief Evaluate an easing curve
+     * @param ease Curve to evaluate
+     * @param t Linear progress, clamped to [0, 1]
+     * @return Eased progress; Back and Elastic curves overshoot [0, 1]
+     */
+    static float Evaluate(Ease ease, float t);
+
+    // Plain values; the tween starts from the value's current contents
+    Handle To(float* value, float to, float duration, Ease ease = Ease::Linear);
+    Handle To(Vector2D* value, const Vector2D& to, float duration, Ease ease = Ease::Linear);
+    Handle To(SDL_Color* value, const SDL_Color& to, float duration, Ease ease = Ease::Linear);
+
+    /**
+     * @brief Tween a value through a setter
+     * @param apply Called every update with the interpolated value; must not start or kill tweens
+     */
+    Handle To(float from, float to, float duration, std::function<void(float)> apply, Ease ease = Ease::Linear);
+
+    // Camera properties, set through the camera so its view is rebuilt
+    Handle MoveTo(Camera& camera, const Vector2D& to, float duration, Ease ease = Ease::Linear);
+    Handle ZoomTo(Camera& camera, float to, float duration, Ease ease = Ease::Linear);
+    Handle RotateTo(Camera& camera, float degrees, float duration, Ease ease = Ease::Linear);
+
+    // UI element properties
+    Handle MoveTo(UIElement& element, const Vector2D& to, float duration, Ease ease = Ease::Linear);
+    Handle ResizeTo(UIElement& element, const Vector2D& to, float duration, Ease ease = Ease::Linear);
+    Handle ScaleTo(UIElement& element, const Vector2D& to, float duration, Ease ease = Ease::Linear);
+    Handle ColorTo(UIText& text, const SDL_Color& to, float duration, Ease ease = Ease::Linear);
+
+    /**
+     * @brief Wait before a tween starts moving
+     * The start value is still the one captured when the tween was created.
+     */
+    void SetDelay(Handle handle, float delay);
+
+    /**
+     * @brief Repeat a tween after it reaches its end
+     * @param count Extra runs, or -1 to repeat until killed
+     * @param yoyo Play every other run backwards instead of restarting
+     */
+    void SetRepeat(Handle handle, int count, bool yoyo = false);
+
+    /**
+     * @brief Set the function called once the tween finishes
+     * It runs after the update pass, so it may start or kill tweens.
+     */
+    void OnComplete(Handle handle, std::function<void()> callback);
+
+    /**
+     * @brief Stop a tween
+     * @param complete Jump to the end value and call its completion callback
+     */
+    void Kill(Handle handle, bool complete = false);
+
+    /**
+     * @brief Stop every tween of a target without completing them
+     * @param target The value, camera or UI element passed when creating the tweens
+     */
+    void KillTweensOf(const void* target);
+
+    [[nodiscard]] bool IsActive(Handle handle) const { return Find(handle) != kFreeSlot; }
+
+    /**
+     * @brief Advance every tween and write the interpolated values
+     * @param deltaTime Time elapsed since last update in seconds
+     */
+    void Update(float deltaTime);
+
+    [[nodiscard]] size_t GetActiveCount() const { return tweens.size(); }
+
+    /**
+     * @brief Stop all tweens without completing them
+     */
+    void Clear();
+
+private:
+    enum class Property : std::uint8_t {
+        Float,
+        Vector,
+        Color,
+        Custom,
+        CameraPosition,
+        CameraZoom,
+        CameraRotation,
+        UIPosition,
+        UISize,
+        UIScale,
+        UITextColor
+    };
+
+    /**
+     * @brief One active tween; plain data so the update pass stays tight
+     */
+    struct Tween {
+        void* target;
+        std::array<float, 4> from;
+        std::array<float, 4> to;
+        float elapsed = 0.0f;         ///< Negative while delayed
+        float duration;
+        std::int32_t repeat = 0;      ///< Runs left after this one, -1 for forever
+        Property property;
+        Ease ease;
+        bool yoyo = false;
+    };
+
+    /**
+     * @brief Rarely used per-tween functions, kept out of the hot array
+     */
+    struct Callbacks {
+        std::function<void(float)> apply;
+        std::function<void()> onComplete;
+    };
+
+    static constexpr std::uint32_t kFreeSlot = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kSlotBits = 24;
+    static constexpr std::uint32_t kSlotMask = (1u << kSlotBits) - 1;
+
+    Handle Start(Property property, void* target, const std::array<float, 4>& from,
+                 const std::array<float, 4>& to, float duration, Ease ease);
+
+    /**
+     * @brief Get the dense index of a tween
+     * @return The index, or kFreeSlot for a stale or invalid handle
+     */
+    std::uint32_t Find(Handle handle) const;
+
+    void Apply(size_t index, float t);
+    void Remove(size_t index);
+
+    std::vector<Tween> tweens;             ///< Dense, updated in one pass
+    std::vector<Callbacks> callbacks;      ///< Parallel to tweens
+    std::vector<Handle> denseHandles;      ///< Handle of each dense entry
+
+    std::vector<std::uint32_t> sparse;     ///< Dense index per slot, or kFreeSlot
+    std::vector<std::uint8_t> generations; ///< Bumped each time a slot is freed
+    std::vector<std::uint32_t> freeSlots;
+
+    std::vector<Handle> finished;          ///< Completed during the current Update()
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include <SDL_ttf.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,6 +42,8 @@ public:
         }
     }
 
+    const SDL_Color& GetColor() const { return color; }
+
     void SetWrapWidth(int width) {
         if (wrapWidth != width) {
             wrapWidth = width;
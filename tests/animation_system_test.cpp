@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "animationsystem.h"
+
+class AnimationSystemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto walk = std::make_shared<AnimationClip>();
+        walk->name = "walk";
+        walk->frames = {{{0, 0, 16, 16}, 0.1f}, {{16, 0, 16, 16}, 0.1f}};
+        walkClip = system.AddClip(walk);
+
+        auto die = std::make_shared<AnimationClip>();
+        die->name = "die";
+        die->looping = false;
+        die->frames = {{{0, 16, 16, 16}, 0.1f}, {{16, 16, 16, 16}, 0.1f}};
+        dieClip = system.AddClip(die);
+    }
+
+    AnimationSystem system;
+    AnimationSystem::ClipId walkClip = 0;
+    AnimationSystem::ClipId dieClip = 0;
+};
+
+TEST_F(AnimationSystemTest, StateIsCompact) {
+    EXPECT_LE(sizeof(AnimationState), 16u);
+}
+
+TEST_F(AnimationSystemTest, UpdatesAllInstances) {
+    auto a = system.Create(walkClip);
+    auto b = system.Create(dieClip);
+    auto paused = system.Create(walkClip, false);
+    EXPECT_EQ(system.Create(99), AnimationSystem::kInvalidHandle);
+
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetCurrentFrame(a)->sourceRect.x, 16);
+    EXPECT_EQ(system.GetCurrentFrame(b)->sourceRect.x, 16);
+    EXPECT_EQ(system.GetCurrentFrame(paused)->sourceRect.x, 0);
+
+    // Looping wraps around, non-looping stops
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetCurrentFrame(a)->sourceRect.x, 0);
+    EXPECT_TRUE(system.GetState(a)->playing);
+    EXPECT_FALSE(system.GetState(b)->playing);
+}
+
+TEST_F(AnimationSystemTest, HandlesSurviveDestroy) {
+    auto a = system.Create(walkClip);
+    auto b = system.Create(dieClip);
+    auto c = system.Create(walkClip);
+
+    system.Destroy(a);
+    EXPECT_FALSE(system.IsValid(a));
+    EXPECT_EQ(system.GetState(a), nullptr);
+    EXPECT_EQ(system.GetInstanceCount(), 2);
+
+    // The other handles still reach their own states
+    EXPECT_EQ(system.GetState(b)->clip, dieClip);
+    EXPECT_EQ(system.GetState(c)->clip, walkClip);
+
+    system.Play(c, dieClip);
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetCurrentFrame(c)->sourceRect.y, 16);
+    EXPECT_EQ(system.GetCurrentFrame(c)->sourceRect.x, 16);
+
+    // Destroyed handles are reused
+    auto d = system.Create(walkClip);
+    EXPECT_EQ(d, a);
+    EXPECT_EQ(system.GetState(d)->frame, 0u);
+}
+
+TEST_F(AnimationSystemTest, PauseResumeStop) {
+    auto a = system.Create(walkClip);
+    system.Pause(a);
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetState(a)->frame, 0u);
+
+    system.Resume(a);
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetState(a)->frame, 1u);
+
+    system.Stop(a);
+    EXPECT_FALSE(system.GetState(a)->playing);
+    EXPECT_EQ(system.GetState(a)->frame, 0u);
+}
+
+TEST_F(AnimationSystemTest, FrameEventsAndSeek) {
+    auto a = system.Create(walkClip);
+    auto b = system.Create(dieClip);
+
+    std::vector<std::pair<AnimationSystem::Handle, std::uint32_t>> events;
+    system.SetFrameCallback([&](AnimationSystem::Handle handle, AnimationSystem::ClipId, std::uint32_t frame) {
+        events.emplace_back(handle, frame);
+    });
+
+    // One slow tick crosses every frame of both clips
+    system.Update(0.35f);
+    EXPECT_EQ(system.GetState(a)->frame, 1u);
+    EXPECT_FALSE(system.GetState(b)->playing);
+    using Event = std::pair<AnimationSystem::Handle, std::uint32_t>;
+    EXPECT_EQ(events, (std::vector<Event>{{a, 1}, {a, 0}, {a, 1}, {b, 1}}));
+
+    events.clear();
+    system.Seek(a, 0.05f);
+    EXPECT_EQ(system.GetState(a)->frame, 0u);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(AnimationSystemTest, StateMachineTransitions) {
+    auto machine = std::make_shared<AnimationStateMachine>();
+    const auto walk = machine->AddState("walk", walkClip);
+    const auto die = machine->AddState("die", dieClip);
+    const auto idle = machine->AddState("idle", walkClip);
+    const auto hit = machine->AddParameter("hit", 0.0f, true);
+    machine->AddTransition({walk, die, {{hit, AnimationStateMachine::Compare::Greater, 0.5f}}, false, 0.1f});
+    machine->AddTransition({die, idle, {}, true});
+    const auto id = system.AddStateMachine(machine);
+
+    auto a = system.Create(walkClip);
+    ASSERT_TRUE(system.AttachStateMachine(a, id));
+    EXPECT_EQ(system.GetMachineState(a), walk);
+
+    std::vector<std::pair<AnimationSystem::StateId, AnimationSystem::StateId>> changes;
+    system.SetStateCallback([&](AnimationSystem::Handle, AnimationSystem::StateId from, AnimationSystem::StateId to) {
+        changes.emplace_back(from, to);
+    });
+    int finished = 0;
+    system.SetFinishedCallback([&](AnimationSystem::Handle, AnimationSystem::ClipId) { ++finished; });
+
+    system.Update(0.05f);
+    EXPECT_EQ(system.GetMachineState(a), walk);
+
+    // The trigger fires the transition once and is consumed
+    system.SetTrigger(a, hit);
+    system.Update(0.05f);
+    EXPECT_EQ(system.GetMachineState(a), die);
+    EXPECT_EQ(system.GetState(a)->clip, dieClip);
+    EXPECT_FLOAT_EQ(system.GetParameter(a, hit), 0.0f);
+
+    // The old clip fades out while the new one plays
+    AnimationSystem::Blend blend = system.GetBlend(a);
+    ASSERT_NE(blend.frame, nullptr);
+    EXPECT_FLOAT_EQ(blend.weight, 1.0f);
+    system.Update(0.05f);
+    EXPECT_NEAR(system.GetBlend(a).weight, 0.5f, 1e-4f);
+
+    // The die clip finishing moves on to idle without polling
+    system.Update(0.2f);
+    EXPECT_EQ(finished, 1);
+    EXPECT_EQ(system.GetMachineState(a), idle);
+    EXPECT_EQ(system.GetBlend(a).frame, nullptr);
+    using Change = std::pair<AnimationSystem::StateId, AnimationSystem::StateId>;
+    EXPECT_EQ(changes, (std::vector<Change>{{walk, die}, {die, idle}}));
+
+    system.Destroy(a);
+    EXPECT_EQ(system.GetMachineState(a), AnimationStateMachine::kInvalidState);
+}
+
+TEST_F(AnimationSystemTest, StateMachineDetectsLoopEnds) {
+    auto machine = std::make_shared<AnimationStateMachine>();
+    const auto walk = machine->AddState("walk", walkClip);
+    const auto idle = machine->AddState("idle", walkClip);
+    machine->AddTransition({walk, idle, {}, true});
+    const auto id = system.AddStateMachine(machine);
+
+    auto a = system.Create(walkClip);
+    ASSERT_TRUE(system.AttachStateMachine(a, id));
+
+    // Restarting by hand is not the end of a loop
+    system.Update(0.15f);
+    system.Play(a, walkClip);
+    system.Update(0.05f);
+    EXPECT_EQ(system.GetMachineState(a), walk);
+
+    // One delta that wraps past the previous time still ends the loop
+    system.Update(0.25f);
+    EXPECT_EQ(system.GetMachineState(a), idle);
+}
@@ -93,3 +93,44 @@ TEST_F(AnimationTest, NonLoopingBehavior) {
     EXPECT_FALSE(animation->IsPlaying());
     EXPECT_EQ(animation->GetCurrentFrame().sourceRect.x, frame2.x);
 }
+
+TEST_F(AnimationTest, LargeDeltaSkipsFrames) {
+    for (int i = 0; i < 4; ++i) {
+        animation->AddFrame({i * 32, 0, 32, 32}, 0.1f);
+    }
+    animation->Play();
+
+    std::vector<std::uint32_t> entered;
+    animation->SetFrameCallback([&](std::uint32_t frame) { entered.push_back(frame); });
+
+    // A single hitch lands on the frame real time says we should be on
+    animation->Update(0.25f);
+    EXPECT_EQ(animation->GetCurrentFrameIndex(), 2u);
+    EXPECT_EQ(entered, (std::vector<std::uint32_t>{1, 2}));
+
+    // Wrapping reports the frames on both sides of the loop
+    entered.clear();
+    animation->Update(0.2f);
+    EXPECT_EQ(animation->GetCurrentFrameIndex(), 0u);
+    EXPECT_EQ(entered, (std::vector<std::uint32_t>{3, 0}));
+}
+
+TEST_F(AnimationTest, SeekToTime) {
+    animation->AddFrame({0, 0, 32, 32}, 0.1f);
+    animation->AddFrame({32, 0, 32, 32}, 0.3f);
+    animation->AddFrame({64, 0, 32, 32}, 0.1f);
+    EXPECT_FLOAT_EQ(animation->GetDuration(), 0.5f);
+
+    animation->Seek(0.35f);
+    EXPECT_EQ(animation->GetCurrentFrameIndex(), 1u);
+
+    // Looping animations wrap the seek time
+    animation->Seek(0.95f);
+    EXPECT_EQ(animation->GetCurrentFrameIndex(), 2u);
+
+    auto once = std::make_unique<Animation>("once", false);
+    once->AddFrame({0, 0, 32, 32}, 0.1f);
+    once->AddFrame({32, 0, 32, 32}, 0.1f);
+    once->Seek(5.0f);
+    EXPECT_EQ(once->GetCurrentFrameIndex(), 1u);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "asset-cache.h"
+#include <memory>
+#include <string>
+
+class AssetCacheTest : public ::testing::Test {
+protected:
+    AssetId Id(const std::string& path) { return paths.Intern(path); }
+
+    AssetPathTable paths;
+    AssetCache<int> cache;
+};
+
+TEST_F(AssetCacheTest, FindCountsHitsAndMisses) {
+    EXPECT_EQ(cache.Find(Id("a")), nullptr);
+    cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+
+    auto found = cache.Find(Id("a"));
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, 1);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_FLOAT_EQ(stats.GetHitRate(), 0.5f);
+    EXPECT_EQ(stats.bytesResident, 10);
+    EXPECT_EQ(stats.assetCount, 1);
+}
+
+TEST_F(AssetCacheTest, InsertKeepsExistingAsset) {
+    auto first = cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+    auto second = cache.Insert(Id("a"), std::make_shared<int>(2), 10);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(*second, 1);
+    EXPECT_EQ(cache.GetStats().bytesResident, 10);
+}
+
+TEST_F(AssetCacheTest, EvictsLeastRecentlyUsedFirst) {
+    cache.SetBudget(25);
+    cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+    cache.Insert(Id("b"), std::make_shared<int>(2), 10);
+
+    // Touch "a" so "b" becomes the least recently used
+    cache.Find(Id("a"));
+    cache.Insert(Id("c"), std::make_shared<int>(3), 10);
+
+    EXPECT_TRUE(cache.Contains(Id("a")));
+    EXPECT_FALSE(cache.Contains(Id("b")));
+    EXPECT_TRUE(cache.Contains(Id("c")));
+    EXPECT_EQ(cache.GetStats().evictions, 1);
+    EXPECT_EQ(cache.GetStats().bytesResident, 20);
+}
+
+TEST_F(AssetCacheTest, NeverEvictsReferencedAssets) {
+    cache.SetBudget(15);
+    auto held = cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+    cache.Insert(Id("b"), std::make_shared<int>(2), 10);
+
+    // "a" is still in use, so the cache stays over budget
+    EXPECT_TRUE(cache.Contains(Id("a")));
+    EXPECT_TRUE(cache.Contains(Id("b")));
+    EXPECT_TRUE(cache.IsOverBudget());
+
+    held.reset();
+    cache.Trim();
+    EXPECT_FALSE(cache.Contains(Id("a")));
+    EXPECT_TRUE(cache.Contains(Id("b")));
+    EXPECT_FALSE(cache.IsOverBudget());
+}
+
+TEST_F(AssetCacheTest, UnlimitedBudgetNeverEvicts) {
+    for (int i = 0; i < 100; ++i) {
+        cache.Insert(Id(std::to_string(i)), std::make_shared<int>(i), 1000);
+    }
+    EXPECT_EQ(cache.Size(), 100);
+    EXPECT_EQ(cache.GetStats().evictions, 0);
+}
+
+TEST_F(AssetCacheTest, EraseAndClearReleaseBytes) {
+    cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+    cache.Insert(Id("b"), std::make_shared<int>(2), 5);
+
+    EXPECT_TRUE(cache.Erase(Id("a")));
+    EXPECT_FALSE(cache.Erase(Id("a")));
+    EXPECT_EQ(cache.GetStats().bytesResident, 5);
+
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.GetStats().bytesResident, 0);
+}
+
+TEST_F(AssetCacheTest, ReplaceSwapsAssetAndBytes) {
+    auto old = cache.Insert(Id("a"), std::make_shared<int>(1), 10);
+    EXPECT_FALSE(cache.Replace(Id("missing"), std::make_shared<int>(3), 5));
+
+    EXPECT_TRUE(cache.Replace(Id("a"), std::make_shared<int>(2), 30));
+    EXPECT_EQ(*cache.Peek(Id("a")), 2);
+    EXPECT_EQ(*old, 1);
+    EXPECT_EQ(cache.GetStats().bytesResident, 30);
+}
+
+TEST(AssetPathTableTest, InternsEachPathOnce) {
+    AssetPathTable paths;
+    AssetId player = paths.Intern("assets/player.png");
+    AssetId jump = paths.Intern(std::string("assets/jump.wav"));
+
+    EXPECT_NE(player, jump);
+    EXPECT_EQ(paths.Intern("assets/player.png"), player);
+    EXPECT_EQ(paths.Find("assets/jump.wav"), jump);
+    EXPECT_EQ(paths.Find("assets/missing.png"), AssetId::Invalid);
+    EXPECT_EQ(paths.GetPath(player), "assets/player.png");
+    EXPECT_EQ(paths.GetPath(AssetId::Invalid), "");
+    EXPECT_EQ(paths.Size(), 2);
+}
+
+TEST_F(AssetCacheTest, ErasedIdCanBeCachedAgain) {
+    AssetId a = Id("a");
+    cache.Insert(a, std::make_shared<int>(1), 10);
+    cache.Erase(a);
+    EXPECT_EQ(cache.Peek(a), nullptr);
+
+    cache.Insert(a, std::make_shared<int>(2), 10);
+    EXPECT_EQ(*cache.Find(a), 2);
+}
+
+TEST_F(AssetCacheTest, EraseUnreferencedSkipsHeldAssets) {
+    auto held = cache.Insert(Id("held"), std::make_shared<int>(1), 10);
+    cache.Insert(Id("unused"), std::make_shared<int>(2), 10);
+    cache.Insert(Id("kept"), std::make_shared<int>(3), 10);
+
+    AssetId kept = Id("kept");
+    EXPECT_EQ(cache.EraseUnreferenced([kept](AssetId id) { return id != kept; }), 1);
+    EXPECT_TRUE(cache.Contains(Id("held")));
+    EXPECT_FALSE(cache.Contains(Id("unused")));
+    EXPECT_TRUE(cache.Contains(Id("kept")));
+    EXPECT_EQ(cache.GetStats().bytesResident, 20);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "asset-pack.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class AssetPackTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(packPath.c_str());
+    }
+
+    static std::vector<std::uint8_t> Bytes(const std::string& text) {
+        return std::vector<std::uint8_t>(text.begin(), text.end());
+    }
+
+    std::string packPath = ::testing::TempDir() + "asset_pack_test.gfpack";
+};
+
+TEST_F(AssetPackTest, RoundTrip) {
+    AssetPackWriter writer;
+    writer.AddEntry("sprites/player.png", Bytes("player pixels"));
+    writer.AddEntry("sounds/jump.wav", Bytes("jump samples"));
+    writer.AddEntry("empty.txt", {});
+    ASSERT_TRUE(writer.Write(packPath));
+
+    auto pack = AssetPack::Open(packPath);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_EQ(pack->GetEntries().size(), 3);
+
+    const AssetPack::Entry* entry = pack->Find("sprites/player.png");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(entry->data), entry->size), "player pixels");
+
+    std::vector<std::uint8_t> contents;
+    ASSERT_TRUE(pack->Extract(*pack->Find("sounds/jump.wav"), contents));
+    EXPECT_EQ(contents, Bytes("jump samples"));
+
+    ASSERT_NE(pack->Find("empty.txt"), nullptr);
+    EXPECT_EQ(pack->Find("empty.txt")->size, 0);
+    EXPECT_EQ(pack->Find("missing.png"), nullptr);
+}
+
+TEST_F(AssetPackTest, BlobsAreAligned) {
+    AssetPackWriter writer;
+    writer.AddEntry("a", Bytes("x"));
+    writer.AddEntry("b", Bytes("yyy"));
+    writer.AddEntry("c", Bytes("zzzzz"));
+    ASSERT_TRUE(writer.Write(packPath));
+
+    auto pack = AssetPack::Open(packPath);
+    ASSERT_NE(pack, nullptr);
+    const std::uint8_t* base = pack->GetEntries().front().data;
+    for (const auto& entry : pack->GetEntries()) {
+        EXPECT_EQ((entry.data - base) % AssetPack::kBlobAlignment, 0) << entry.name;
+    }
+}
+
+TEST_F(AssetPackTest, CompressedEntriesRoundTrip) {
+    std::string repetitive(4096, 'a');
+
+    AssetPackWriter writer;
+    writer.SetCompression(true);
+    writer.AddEntry("level.txt", Bytes(repetitive));
+    ASSERT_TRUE(writer.Write(packPath));
+
+    auto pack = AssetPack::Open(packPath);
+    ASSERT_NE(pack, nullptr);
+    const AssetPack::Entry* entry = pack->Find("level.txt");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size, repetitive.size());
+
+    if (AssetPack::IsCompressionSupported()) {
+        EXPECT_EQ(entry->compression, AssetPack::Compression::LZ4);
+        EXPECT_LT(entry->storedSize, entry->size);
+    } else {
+        EXPECT_EQ(entry->compression, AssetPack::Compression::None);
+    }
+
+    std::vector<std::uint8_t> contents;
+    ASSERT_TRUE(pack->Extract(*entry, contents));
+    EXPECT_EQ(contents, Bytes(repetitive));
+}
+
+TEST_F(AssetPackTest, RejectsMalformedFiles) {
+    EXPECT_EQ(AssetPack::Open(packPath), nullptr);
+
+    std::ofstream(packPath, std::ios::binary) << "not a pack file";
+    EXPECT_EQ(AssetPack::Open(packPath), nullptr);
+}
+
+TEST_F(AssetPackTest, RejectsEntrySizesBeyondStoredData) {
+    AssetPackWriter writer;
+    writer.AddEntry("data.bin", Bytes("sixteen bytes!!!"));
+    ASSERT_TRUE(writer.Write(packPath));
+    ASSERT_NE(AssetPack::Open(packPath), nullptr);
+
+    // The uncompressed size of the first index entry follows its offset and stored size
+    auto patchSize = [this](std::uint64_t size) {
+        std::fstream file(packPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(AssetPack::kHeaderSize + 16);
+        for (int i = 0; i < 8; ++i) {
+            file.put(static_cast<char>(size >> (i * 8)));
+        }
+    };
+
+    patchSize(4096);
+    EXPECT_EQ(AssetPack::Open(packPath), nullptr);
+
+    patchSize(std::uint64_t(1) << 32);
+    EXPECT_EQ(AssetPack::Open(packPath), nullptr);
+
+    patchSize(16);
+    EXPECT_NE(AssetPack::Open(packPath), nullptr);
+}
@@ -132,3 +132,56 @@ TEST_F(CameraTest, Shake) {
     EXPECT_FLOAT_EQ(shakeOffset.x, 0.0f);
     EXPECT_FLOAT_EQ(shakeOffset.y, 0.0f);
 }
+
+TEST_F(CameraTest, ShakenViewRectFollowsDrawnView) {
+    Camera camera(SDL_Rect{0, 0, 800, 600});
+    camera.SetPosition(Vector2D(0, 0));
+    camera.SetZoom(2.0f);
+    camera.Shake(1.0f, 20.0f);
+    camera.Update(0.1f);
+
+    // The view is centered on the world point drawn at the viewport center
+    Vector2D drawnCenter = camera.ScreenToWorld(Vector2D(400, 300));
+    SDL_Rect view = camera.GetViewRect();
+    EXPECT_NEAR(view.x + view.w / 2.0f, drawnCenter.x, 1.0f);
+    EXPECT_NEAR(view.y + view.h / 2.0f, drawnCenter.y, 1.0f);
+    EXPECT_GT(std::fabs(drawnCenter.x) + std::fabs(drawnCenter.y), 5.0f);
+}
+
+TEST_F(CameraTest, IndependentInstances) {
+    Camera left(SDL_Rect{0, 0, 400, 600});
+    Camera right(SDL_Rect{400, 0, 400, 600});
+    left.SetPosition(Vector2D(0, 0));
+    right.SetPosition(Vector2D(1000, 0));
+
+    // The same world point lands in each camera's own viewport
+    Vector2D leftScreen = left.WorldToScreen(Vector2D(0, 0));
+    Vector2D rightScreen = right.WorldToScreen(Vector2D(1000, 0));
+    EXPECT_NEAR(leftScreen.x, 200.0f, 0.1f);
+    EXPECT_NEAR(rightScreen.x, 600.0f, 0.1f);
+
+    // Neither affects the shared instance
+    EXPECT_EQ(Camera::Instance().GetPosition(), Vector2D(0, 0));
+}
+
+TEST_F(CameraTest, RotatedViewRectEnclosesView) {
+    Camera camera(SDL_Rect{0, 0, 800, 600});
+    camera.SetPosition(Vector2D(0, 0));
+    camera.SetRotation(90.0f);
+
+    // A quarter turn swaps the visible extents
+    SDL_Rect view = camera.GetViewRect();
+    EXPECT_NEAR(view.w, 600, 1);
+    EXPECT_NEAR(view.h, 800, 1);
+}
+
+TEST_F(CameraTest, ActiveCamera) {
+    EXPECT_EQ(Camera::GetActive(), nullptr);
+
+    Camera camera(SDL_Rect{0, 0, 800, 600});
+    Camera::SetActive(&camera);
+    EXPECT_EQ(Camera::GetActive(), &camera);
+
+    Camera::SetActive(nullptr);
+    EXPECT_EQ(Camera::GetActive(), nullptr);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "debug/debug_logger.h"
+#include "debug/binarylog.h"
 #include <fstream>
 #include <string>
 #include <thread>
@@ -25,6 +26,7 @@ protected:
     }
 
     std::string ReadLogFile() {
+        DebugLogger::Instance().Flush();
         std::ifstream file(logFilename);
         std::string content((std::istreambuf_iterator<char>(file)),
                            std::istreambuf_iterator<char>());
@@ -34,65 +36,70 @@ protected:
     std::string logFilename;
 };
 
-// TEST_F(DebugLoggerTest, LogLevels) {
-//     LOG_DEBUG("Debug message");
-//     LOG_INFO("Info message");
-//     LOG_WARNING("Warning message");
-//     LOG_ERROR("Error message");
-//     LOG_FATAL("Fatal message");
-
-//     std::string content = ReadLogFile();
-//     EXPECT_TRUE(content.find("[DEBUG]") != std::string::npos);
-//     EXPECT_TRUE(content.find("[INFO]") != std::string::npos);
-//     EXPECT_TRUE(content.find("[WARNING]") != std::string::npos);
-//     EXPECT_TRUE(content.find("[ERROR]") != std::string::npos);
-//     EXPECT_TRUE(content.find("[FATAL]") != std::string::npos);
-// }
-
-// TEST_F(DebugLoggerTest, LogFormatting) {
-//     LOG_INFO("Test message");
-//     std::string content = ReadLogFile();
-
-//     // Check timestamp format: YYYY-MM-DD HH:MM:SS.mmm
-//     std::regex timestamp_regex(R"(\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{3})");
-//     EXPECT_TRUE(std::regex_search(content, timestamp_regex));
-// }
-
-// TEST_F(DebugLoggerTest, MultipleArguments) {
-//     LOG_INFO("Value1: ", 42, " Value2: ", 3.14, " Text: ", "test");
-//     std::string content = ReadLogFile();
-//     EXPECT_TRUE(content.find("Value1: 42 Value2: 3.14 Text: test") != std::string::npos);
-// }
-
-// TEST_F(DebugLoggerTest, ConcurrentLogging) {
-//     const int numThreads = 10;
-//     const int numLogsPerThread = 100;
-//     std::vector<std::thread> threads;
-
-//     for (int i = 0; i < numThreads; ++i) {
-//         threads.emplace_back([i, numLogsPerThread]() {
-//             for (int j = 0; j < numLogsPerThread; ++j) {
-//                 LOG_INFO("Thread ", i, " Log ", j);
-//             }
-//         });
-//     }
-
-//     for (auto& thread : threads) {
-//         thread.join();
-//     }
-
-//     std::string content = ReadLogFile();
-//     int logCount = 0;
-//     std::string::size_type pos = 0;
-//     while ((pos = content.find("[INFO]", pos)) != std::string::npos) {
-//         ++logCount;
-//         pos += 6;
-//     }
-
-//     EXPECT_EQ(logCount, numThreads * numLogsPerThread + 1); // +1 for initialization log
-// }
+TEST_F(DebugLoggerTest, LogLevels) {
+    LOG_DEBUG("Debug message");
+    LOG_INFO("Info message");
+    LOG_WARNING("Warning message");
+    LOG_ERROR("Error message");
+    LOG_FATAL("Fatal message");
+
+    std::string content = ReadLogFile();
+#if GAMEFRAMEWORK_LOG_LEVEL == 0
+    EXPECT_TRUE(content.find("[DEBUG]") != std::string::npos);
+#endif
+    EXPECT_TRUE(content.find("[INFO]") != std::string::npos);
+    EXPECT_TRUE(content.find("[WARNING]") != std::string::npos);
+    EXPECT_TRUE(content.find("[ERROR]") != std::string::npos);
+    EXPECT_TRUE(content.find("[FATAL]") != std::string::npos);
+}
+
+TEST_F(DebugLoggerTest, LogFormatting) {
+    LOG_INFO("Test message");
+    std::string content = ReadLogFile();
+
+    // Check timestamp format: YYYY-MM-DD HH:MM:SS.mmm
+    std::regex timestamp_regex(R"(\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{3})");
+    EXPECT_TRUE(std::regex_search(content, timestamp_regex));
+}
+
+TEST_F(DebugLoggerTest, MultipleArguments) {
+    LOG_INFO("Value1: ", 42, " Value2: ", 3.14, " Text: ", "test");
+    std::string content = ReadLogFile();
+    EXPECT_TRUE(content.find("Value1: 42 Value2: 3.14 Text: test") != std::string::npos);
+}
+
+TEST_F(DebugLoggerTest, ConcurrentLogging) {
+    const int numThreads = 10;
+    const int numLogsPerThread = 100;
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([i, numLogsPerThread]() {
+            for (int j = 0; j < numLogsPerThread; ++j) {
+                LOG_INFO("Thread ", i, " Log ", j);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::string content = ReadLogFile();
+    int logCount = 0;
+    std::string::size_type pos = 0;
+    while ((pos = content.find("[INFO]", pos)) != std::string::npos) {
+        ++logCount;
+        pos += 6;
+    }
+
+    EXPECT_EQ(logCount, numThreads * numLogsPerThread + 1); // +1 for initialization log
+}
 
 TEST_F(DebugLoggerTest, ScopeTimer) {
+#if GAMEFRAMEWORK_LOG_LEVEL > 0
+    GTEST_SKIP() << "Debug logging is compiled out";
+#endif
     {
         SCOPE_TIMER("TestScope");
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -104,6 +111,9 @@ TEST_F(DebugLoggerTest, ScopeTimer) {
 }
 
 TEST_F(DebugLoggerTest, NestedScopeTimers) {
+#if GAMEFRAMEWORK_LOG_LEVEL > 0
+    GTEST_SKIP() << "Debug logging is compiled out";
+#endif
     {
         SCOPE_TIMER("OuterScope");
         {
@@ -130,6 +140,7 @@ TEST_F(DebugLoggerTest, LoggerReinitialization) {
     std::string newLogFile = "test2.log";
     DebugLogger::Instance().Initialize(newLogFile);
     LOG_INFO("Second log");
+    DebugLogger::Instance().Flush();
     
     // Check first log file
     std::string content1 = ReadLogFile();
@@ -162,3 +173,133 @@ TEST_F(DebugLoggerTest, LoggerPerformance) {
     // Log rate should be at least 1000 logs per second
     EXPECT_LT(duration.count(), numLogs); // Less than 1ms per log
 }
+
+TEST_F(DebugLoggerTest, DropOverflowReportsLostMessages) {
+    LogOptions options;
+    options.overflow = LogOverflow::Drop;
+    options.console = false;
+    options.bufferSize = 256;
+    DebugLogger::Instance().Initialize(logFilename, options);
+
+    // A fresh thread gets a buffer of the configured size
+    std::thread([]() {
+        for (int i = 0; i < 1000; ++i) {
+            LOG_INFO("Message that fills the small buffer quickly ", i);
+        }
+    }).join();
+
+    std::string content = ReadLogFile();
+    EXPECT_TRUE(content.find("log messages dropped") != std::string::npos);
+}
+
+TEST_F(DebugLoggerTest, MinLevelSkipsArguments) {
+    auto& logger = DebugLogger::Instance();
+    int evaluated = 0;
+    auto expensive = [&evaluated]() {
+        ++evaluated;
+        return std::string("expensive");
+    };
+
+    logger.SetMinLevel(LogLevel::Warning);
+    EXPECT_FALSE(logger.ShouldLog(LogLevel::Info));
+    EXPECT_TRUE(logger.ShouldLog(LogLevel::Error));
+
+    LOG_INFO("Filtered ", expensive());
+    logger.Info("Filtered lazily ", expensive);
+    EXPECT_EQ(evaluated, 0);
+
+    LOG_WARNING("Written ", expensive);
+    EXPECT_EQ(evaluated, 1);
+    logger.SetMinLevel(LogLevel::Debug);
+
+    std::string content = ReadLogFile();
+    EXPECT_TRUE(content.find("Filtered") == std::string::npos);
+    EXPECT_TRUE(content.find("[WARNING] Written expensive") != std::string::npos);
+}
+
+TEST_F(DebugLoggerTest, FormatMacrosSubstituteArguments) {
+    LOGF_WARNING("Player {} at {}, {} alive {}", 7, 1.5f, -2.25, true);
+    LOGF_WARNING("Name {} extra ", std::string("hero"), 'x', 42u);
+    LOGF_WARNING("Missing {} and {}", "one");
+    LOGF_WARNING("No arguments");
+
+    std::string content = ReadLogFile();
+    EXPECT_TRUE(content.find("[WARNING] Player 7 at 1.5, -2.25 alive 1") != std::string::npos);
+    EXPECT_TRUE(content.find("[WARNING] Name hero extra x42") != std::string::npos);
+    EXPECT_TRUE(content.find("[WARNING] Missing one and {}") != std::string::npos);
+    EXPECT_TRUE(content.find("[WARNING] No arguments") != std::string::npos);
+}
+
+TEST_F(DebugLoggerTest, BinaryLogDecodesToText) {
+    const std::string binaryFilename = "test.gflog";
+    LogOptions options;
+    options.encoding = LogEncoding::Binary;
+    options.console = false;
+    DebugLogger::Instance().Initialize(binaryFilename, options);
+
+    for (int i = 0; i < 3; ++i) {
+        LOGF_ERROR("Frame {} took {} ms on {}", i, 16.5, std::string("main"));
+    }
+    LOG_ERROR("Plain ", "text");
+    DebugLogger::Instance().Shutdown();
+
+    BinaryLogReader reader;
+    ASSERT_TRUE(reader.Open(binaryFilename));
+    std::vector<std::string> lines;
+    BinaryLogReader::Entry entry;
+    while (reader.Next(entry)) {
+        if (entry.level == LogLevel::Error) {
+            EXPECT_GT(entry.timestamp, 0);
+            lines.push_back(entry.text);
+        }
+    }
+    EXPECT_FALSE(reader.HasError());
+    std::filesystem::remove(binaryFilename);
+
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "Frame 0 took 16.5 ms on main");
+    EXPECT_EQ(lines[2], "Frame 2 took 16.5 ms on main");
+    EXPECT_EQ(lines[3], "Plain text");
+}
+
+TEST_F(DebugLoggerTest, BinaryLogRejectsCorruptSizes) {
+    const std::string binaryFilename = "corrupt.gflog";
+    auto writeLog = [&](auto&& writeRecords) {
+        std::ofstream out(binaryFilename, std::ios::binary | std::ios::trunc);
+        out.write(BinaryLog::kMagic, sizeof(BinaryLog::kMagic));
+        out.write(reinterpret_cast<const char*>(&BinaryLog::kVersion), sizeof(BinaryLog::kVersion));
+        writeRecords(out);
+    };
+    auto write = [](std::ofstream& out, auto value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto expectError = [&]() {
+        BinaryLogReader reader;
+        ASSERT_TRUE(reader.Open(binaryFilename));
+        BinaryLogReader::Entry entry;
+        EXPECT_FALSE(reader.Next(entry));
+        EXPECT_TRUE(reader.HasError());
+    };
+
+    // A payload length far beyond the end of the file
+    writeLog([&](std::ofstream& out) {
+        write(out, BinaryLog::RecordType::Message);
+        write(out, std::int64_t(1));
+        write(out, std::uint8_t(0));
+        write(out, std::uint32_t(0));
+        write(out, std::uint32_t(0xFFFFFFF0u));
+        out << "short";
+    });
+    expectError();
+
+    // A format ID that skips ahead
+    writeLog([&](std::ofstream& out) {
+        write(out, BinaryLog::RecordType::Format);
+        write(out, std::uint32_t(0x7FFFFFFFu));
+        write(out, std::uint32_t(0));
+        write(out, std::uint32_t(0));
+    });
+    expectError();
+
+    std::filesystem::remove(binaryFilename);
+}
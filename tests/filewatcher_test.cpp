@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "filewatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FileWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+
+    void WriteFile(const std::string& path, const std::string& contents) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents;
+    }
+
+    // Callback target recording reported paths
+    void OnChange(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changed.push_back(path);
+        condition.notify_all();
+    }
+
+    bool WaitForChange(const std::string& path) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return condition.wait_for(lock, std::chrono::seconds(5), [&]() {
+            return std::find(changed.begin(), changed.end(), path) != changed.end();
+        });
+    }
+
+    std::string directory = ::testing::TempDir() + "filewatcher_test";
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::string> changed;
+};
+
+TEST_F(FileWatcherTest, ReportsRewrittenFile) {
+    const std::string path = directory + "/sprite.png";
+    WriteFile(path, "old");
+
+    FileWatcher watcher([this](const std::string& p) { OnChange(p); }, 20);
+    watcher.Watch(path);
+
+    // Polling compares modification times, which may have coarse resolution
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) - std::chrono::seconds(10));
+    WriteFile(path, "new");
+
+    EXPECT_TRUE(WaitForChange(path));
+}
+
+TEST_F(FileWatcherTest, ReportsFileReplacedByRename) {
+    const std::string path = directory + "/jump.wav";
+    const std::string temporary = directory + "/jump.wav.tmp";
+    WriteFile(path, "old");
+
+    FileWatcher watcher([this](const std::string& p) { OnChange(p); }, 20);
+    watcher.Watch(path);
+
+    WriteFile(temporary, "new contents");
+    std::filesystem::last_write_time(temporary, std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+    std::filesystem::rename(temporary, path);
+
+    EXPECT_TRUE(WaitForChange(path));
+}
+
+TEST_F(FileWatcherTest, IgnoresUnwatchedFiles) {
+    const std::string watched = directory + "/watched.png";
+    const std::string other = directory + "/other.png";
+    WriteFile(watched, "a");
+    WriteFile(other, "b");
+
+    FileWatcher watcher([this](const std::string& p) { OnChange(p); }, 20);
+    watcher.Watch(watched);
+    watcher.Watch(other);
+    watcher.Unwatch(other);
+
+    std::filesystem::last_write_time(other, std::filesystem::last_write_time(other) - std::chrono::seconds(10));
+    WriteFile(other, "changed");
+    std::filesystem::last_write_time(watched, std::filesystem::last_write_time(watched) - std::chrono::seconds(10));
+    WriteFile(watched, "changed");
+
+    // other was written first, so it would have been reported by now
+    ASSERT_TRUE(WaitForChange(watched));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(std::count(changed.begin(), changed.end(), other), 0);
+}
+
+TEST_F(FileWatcherTest, PollsFileWhoseDirectoryCannotBeWatched) {
+    // The directory does not exist yet, so inotify cannot watch it
+    const std::string subdirectory = directory + "/generated";
+    const std::string path = subdirectory + "/level.json";
+
+    FileWatcher watcher([this](const std::string& p) { OnChange(p); }, 20);
+    watcher.Watch(path);
+
+    std::filesystem::create_directories(subdirectory);
+    WriteFile(path, "{}");
+
+    EXPECT_TRUE(WaitForChange(path));
+}
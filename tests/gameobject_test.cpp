@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "gameobject.h"
+#include <cmath>
+#include <memory>
+
+class GameObjectHierarchyTest : public ::testing::Test {
+protected:
+    bool VectorsEqual(const Vector2D& a, const Vector2D& b, float epsilon = 0.001f) {
+        return std::abs(a.x - b.x) <= epsilon && std::abs(a.y - b.y) <= epsilon;
+    }
+};
+
+TEST_F(GameObjectHierarchyTest, ChildFollowsParent) {
+    GameObject tank("tank");
+    GameObject turret("turret");
+
+    tank.GetTransform().position = Vector2D(100.0f, 50.0f);
+    ASSERT_TRUE(turret.SetParent(&tank, false));
+    turret.GetTransform().position = Vector2D(10.0f, 0.0f);
+
+    EXPECT_EQ(turret.GetParent(), &tank);
+    EXPECT_EQ(tank.GetChildren().size(), 1);
+    EXPECT_EQ(turret.GetHierarchyDepth(), 1);
+    EXPECT_TRUE(VectorsEqual(turret.GetWorldTransform().position, Vector2D(110.0f, 50.0f)));
+
+    // Moving and rotating the parent carries the child along
+    tank.GetTransform().position = Vector2D(0.0f, 0.0f);
+    tank.GetTransform().rotation = 90.0f;
+    const Transform& world = turret.GetWorldTransform();
+    EXPECT_TRUE(VectorsEqual(world.position, Vector2D(0.0f, 10.0f)));
+    EXPECT_NEAR(world.rotation, 90.0f, 0.001f);
+}
+
+TEST_F(GameObjectHierarchyTest, ScaleIsInherited) {
+    GameObject parent;
+    GameObject child;
+
+    parent.GetTransform().scale = Vector2D(2.0f, 3.0f);
+    child.SetParent(&parent, false);
+    child.GetTransform().position = Vector2D(1.0f, 1.0f);
+
+    const Transform& world = child.GetWorldTransform();
+    EXPECT_TRUE(VectorsEqual(world.position, Vector2D(2.0f, 3.0f)));
+    EXPECT_TRUE(VectorsEqual(world.scale, Vector2D(2.0f, 3.0f)));
+}
+
+TEST_F(GameObjectHierarchyTest, KeepWorldTransformOnReparent) {
+    GameObject parent;
+    GameObject child;
+
+    parent.GetTransform().position = Vector2D(50.0f, 0.0f);
+    parent.GetTransform().rotation = 90.0f;
+    child.GetTransform().position = Vector2D(60.0f, 20.0f);
+
+    ASSERT_TRUE(child.SetParent(&parent));
+    EXPECT_TRUE(VectorsEqual(child.GetWorldTransform().position, Vector2D(60.0f, 20.0f)));
+
+    ASSERT_TRUE(child.SetParent(nullptr));
+    EXPECT_TRUE(parent.GetChildren().empty());
+    EXPECT_EQ(child.GetHierarchyDepth(), 0);
+    EXPECT_TRUE(VectorsEqual(child.GetTransform().position, Vector2D(60.0f, 20.0f)));
+}
+
+TEST_F(GameObjectHierarchyTest, RejectsCycles) {
+    GameObject a;
+    GameObject b;
+    GameObject c;
+
+    ASSERT_TRUE(b.SetParent(&a));
+    ASSERT_TRUE(c.SetParent(&b));
+    EXPECT_EQ(c.GetHierarchyDepth(), 2);
+
+    EXPECT_FALSE(a.SetParent(&c));
+    EXPECT_FALSE(a.SetParent(&a));
+    EXPECT_EQ(a.GetParent(), nullptr);
+}
+
+TEST_F(GameObjectHierarchyTest, WorldMatrixOnlyRebuiltWhenInputsChange) {
+    GameObject parent;
+    GameObject child;
+    child.SetParent(&parent, false);
+
+    const Matrix2D* first = &child.GetWorldMatrix();
+    Matrix2D before = *first;
+    EXPECT_EQ(child.GetWorldMatrix(), before);
+
+    parent.GetTransform().position = Vector2D(5.0f, 5.0f);
+    EXPECT_NE(child.GetWorldMatrix(), before);
+    EXPECT_TRUE(VectorsEqual(child.GetWorldMatrix().TransformPoint(Vector2D()), Vector2D(5.0f, 5.0f)));
+}
+
+TEST_F(GameObjectHierarchyTest, DestroyingParentOrphansChildren) {
+    GameObject child;
+    Uint32 generation = GameObject::GetHierarchyGeneration();
+    {
+        GameObject parent;
+        parent.GetTransform().position = Vector2D(30.0f, 40.0f);
+        child.SetParent(&parent, false);
+        child.GetTransform().position = Vector2D(1.0f, 2.0f);
+    }
+
+    EXPECT_EQ(child.GetParent(), nullptr);
+    EXPECT_EQ(child.GetHierarchyDepth(), 0);
+    EXPECT_TRUE(VectorsEqual(child.GetTransform().position, Vector2D(31.0f, 42.0f)));
+    EXPECT_NE(GameObject::GetHierarchyGeneration(), generation);
+}
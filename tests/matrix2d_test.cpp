@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "matrix2d.h"
+#include <cmath>
+
+class Matrix2DTest : public ::testing::Test {
+protected:
+    bool VectorsEqual(const Vector2D& a, const Vector2D& b, float epsilon = 0.0001f) {
+        return std::abs(a.x - b.x) <= epsilon && std::abs(a.y - b.y) <= epsilon;
+    }
+};
+
+TEST_F(Matrix2DTest, DefaultIsIdentity) {
+    Matrix2D m;
+    EXPECT_TRUE(VectorsEqual(m.TransformPoint(Vector2D(3, 4)), Vector2D(3, 4)));
+    EXPECT_EQ(m, Matrix2D(1, 0, 0, 1, 0, 0));
+}
+
+TEST_F(Matrix2DTest, FromTRS) {
+    // Scale by 2, rotate 90 degrees, translate by (10, 20)
+    Matrix2D m = Matrix2D::FromTRS(Vector2D(10, 20), 1.0f, 0.0f, Vector2D(2, 2));
+
+    EXPECT_TRUE(VectorsEqual(m.TransformPoint(Vector2D(1, 0)), Vector2D(10, 22)));
+    EXPECT_TRUE(VectorsEqual(m.TransformPoint(Vector2D(0, 1)), Vector2D(8, 20)));
+    EXPECT_TRUE(VectorsEqual(m.TransformVector(Vector2D(1, 0)), Vector2D(0, 2)));
+}
+
+TEST_F(Matrix2DTest, Multiply) {
+    Matrix2D translate(1, 0, 0, 1, 5, 0);
+    Matrix2D scale(2, 0, 0, 2, 0, 0);
+
+    // Scale first, then translate
+    Matrix2D combined = translate * scale;
+    EXPECT_TRUE(VectorsEqual(combined.TransformPoint(Vector2D(1, 1)), Vector2D(7, 2)));
+}
+
+TEST_F(Matrix2DTest, Inverse) {
+    Matrix2D m = Matrix2D::FromTRS(Vector2D(-3, 7), std::sin(0.5f), std::cos(0.5f), Vector2D(2, 3));
+    Vector2D p(4, -2);
+
+    EXPECT_TRUE(VectorsEqual(m.Inverse().TransformPoint(m.TransformPoint(p)), p));
+
+    // Singular matrices invert to identity
+    Matrix2D singular(0, 0, 0, 0, 1, 1);
+    EXPECT_EQ(singular.Inverse(), Matrix2D());
+}
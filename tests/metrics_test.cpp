@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "debug/metrics.h"
+#include "debug/statsoverlay.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+class MetricsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Metrics::Instance().Reset();
+    }
+
+    void TearDown() override {
+        Metrics::Instance().Reset();
+    }
+};
+
+TEST_F(MetricsTest, RegistryReturnsSameMetric) {
+    auto& metrics = Metrics::Instance();
+    Metrics::Counter& counter = metrics.GetCounter("test.registry");
+    EXPECT_EQ(&counter, &metrics.GetCounter("test.registry"));
+    EXPECT_EQ(&counter, metrics.FindCounter("test.registry"));
+    EXPECT_EQ(metrics.FindCounter("test.unregistered"), nullptr);
+    EXPECT_EQ(metrics.FindGauge("test.registry"), nullptr);
+
+    bool listed = false;
+    for (const Metrics::Info& info : metrics.List()) {
+        if (info.name == "test.registry") {
+            listed = true;
+            EXPECT_EQ(info.type, Metrics::Type::Counter);
+        }
+    }
+    EXPECT_TRUE(listed);
+}
+
+TEST_F(MetricsTest, CounterReportsPerFrameValues) {
+    auto& metrics = Metrics::Instance();
+    Metrics::Counter& counter = metrics.GetCounter("test.counter");
+
+    counter.Add(3);
+    counter.Add();
+    metrics.EndFrame();
+    EXPECT_EQ(counter.GetFrameValue(), 4u);
+
+    counter.Add(10);
+    EXPECT_EQ(counter.GetFrameValue(), 4u);
+    metrics.EndFrame();
+    EXPECT_EQ(counter.GetFrameValue(), 10u);
+    EXPECT_EQ(counter.GetTotal(), 14u);
+
+    metrics.EndFrame();
+    EXPECT_EQ(counter.GetFrameValue(), 0u);
+}
+
+TEST_F(MetricsTest, GaugeSetsAndAdds) {
+    Metrics::Gauge& gauge = Metrics::Instance().GetGauge("test.gauge");
+    gauge.Set(5.0);
+    gauge.Add(2.5);
+    gauge.Add(-1.0);
+    EXPECT_DOUBLE_EQ(gauge.Get(), 6.5);
+
+    Metrics::Instance().Reset();
+    EXPECT_DOUBLE_EQ(gauge.Get(), 0.0);
+}
+
+TEST_F(MetricsTest, HistogramPercentilesAreClose) {
+    Metrics::Histogram& histogram = Metrics::Instance().GetHistogram("test.histogram");
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.Record(i * 0.1);
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_NEAR(snapshot.Mean(), 50.05, 1e-9);
+    EXPECT_NEAR(snapshot.Percentile(50.0), 50.0, 50.0 * 0.035);
+    EXPECT_NEAR(snapshot.Percentile(99.0), 99.0, 99.0 * 0.035);
+    EXPECT_DOUBLE_EQ(histogram.GetMin(), 0.1);
+    EXPECT_DOUBLE_EQ(histogram.GetMax(), 100.0);
+}
+
+TEST_F(MetricsTest, HistogramBucketsCoverRange) {
+    using Histogram = Metrics::Histogram;
+    EXPECT_EQ(Histogram::GetBucket(0.0), 0u);
+    EXPECT_EQ(Histogram::GetBucket(-5.0), 0u);
+    EXPECT_EQ(Histogram::GetBucket(std::nan("")), 0u);
+    EXPECT_EQ(Histogram::GetBucket(1e300), Histogram::kBucketCount - 1);
+
+    // Every bucket's value falls back into that bucket
+    for (size_t bucket = 1; bucket < Histogram::kBucketCount; ++bucket) {
+        EXPECT_EQ(Histogram::GetBucket(Histogram::GetBucketValue(bucket)), bucket);
+    }
+}
+
+TEST_F(MetricsTest, SnapshotSinceCoversWindow) {
+    Metrics::Histogram& histogram = Metrics::Instance().GetHistogram("test.window");
+    for (int i = 0; i < 100; ++i) {
+        histogram.Record(1.0);
+    }
+    const auto before = histogram.GetSnapshot();
+    for (int i = 0; i < 10; ++i) {
+        histogram.Record(20.0);
+    }
+
+    const auto window = histogram.GetSnapshot().Since(before);
+    EXPECT_EQ(window.count, 10u);
+    EXPECT_NEAR(window.Percentile(50.0), 20.0, 20.0 * 0.035);
+    EXPECT_DOUBLE_EQ(window.Mean(), 20.0);
+}
+
+TEST_F(MetricsTest, RecordsFromManyThreads) {
+    Metrics::Counter& counter = Metrics::Instance().GetCounter("test.threads.counter");
+    Metrics::Histogram& histogram = Metrics::Instance().GetHistogram("test.threads.histogram");
+
+    const int numThreads = 4;
+    const int numRecords = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < numRecords; ++i) {
+                counter.Add();
+                histogram.Record(t + 1.0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.GetTotal(), static_cast<std::uint64_t>(numThreads * numRecords));
+    EXPECT_EQ(histogram.GetCount(), static_cast<std::uint64_t>(numThreads * numRecords));
+    EXPECT_EQ(histogram.GetSnapshot().count, static_cast<std::uint64_t>(numThreads * numRecords));
+    EXPECT_DOUBLE_EQ(histogram.GetMin(), 1.0);
+    EXPECT_DOUBLE_EQ(histogram.GetMax(), 4.0);
+}
+
+TEST_F(MetricsTest, StatsOverlayShowsMetrics) {
+    auto& metrics = Metrics::Instance();
+    metrics.GetGauge("frame.fps").Set(60.0);
+    metrics.GetGauge("scene.objects").Set(42.0);
+    metrics.GetCounter("render.draw_calls").Add(17);
+    for (int i = 0; i < 100; ++i) {
+        metrics.GetHistogram("frame.time_ms").Record(16.0);
+    }
+    metrics.EndFrame();
+
+    StatsOverlay overlay;
+    overlay.Refresh();
+    const auto& lines = overlay.GetLines();
+    ASSERT_FALSE(lines.empty());
+    EXPECT_EQ(lines[0].find("FPS 60"), 0u);
+    EXPECT_GT(overlay.GetSize().y, 0.0f);
+
+    bool foundObjects = false;
+    bool foundDrawCalls = false;
+    for (const std::string& line : lines) {
+        foundObjects = foundObjects || line.find("objects 42") != std::string::npos;
+        foundDrawCalls = foundDrawCalls || line.find("draw calls 17") != std::string::npos;
+    }
+    EXPECT_TRUE(foundObjects);
+    EXPECT_TRUE(foundDrawCalls);
+}
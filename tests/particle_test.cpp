@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "particleemitter.h"
+
+class ParticleEmitterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        emitter = std::make_unique<ParticleEmitter>(100);
+
+        ParticleEmitter::Config config;
+        config.emissionRate = 0.0f;
+        config.minLifetime = 1.0f;
+        config.maxLifetime = 1.0f;
+        config.minSpeed = 10.0f;
+        config.maxSpeed = 10.0f;
+        config.direction = 0.0f;
+        config.spread = 0.0f;
+        emitter->SetConfig(config);
+    }
+
+    std::unique_ptr<ParticleEmitter> emitter;
+};
+
+TEST_F(ParticleEmitterTest, InitialState) {
+    EXPECT_EQ(emitter->GetCapacity(), 100);
+    EXPECT_EQ(emitter->GetAliveCount(), 0);
+    EXPECT_TRUE(emitter->IsEmitting());
+}
+
+TEST_F(ParticleEmitterTest, BurstIsClampedToCapacity) {
+    emitter->Emit(60);
+    EXPECT_EQ(emitter->GetAliveCount(), 60);
+
+    emitter->Emit(60);
+    EXPECT_EQ(emitter->GetAliveCount(), 100);
+
+    emitter->Clear();
+    EXPECT_EQ(emitter->GetAliveCount(), 0);
+}
+
+TEST_F(ParticleEmitterTest, ParticlesMoveAlongVelocity) {
+    emitter->GetTransform().position = Vector2D(100, 50);
+    emitter->Emit(1);
+    EXPECT_EQ(emitter->GetParticlePosition(0), Vector2D(100, 50));
+
+    emitter->Update(0.5f);
+    Vector2D pos = emitter->GetParticlePosition(0);
+    EXPECT_NEAR(pos.x, 105.0f, 0.001f);
+    EXPECT_NEAR(pos.y, 50.0f, 0.001f);
+}
+
+TEST_F(ParticleEmitterTest, GravityAcceleratesParticles) {
+    auto config = emitter->GetConfig();
+    config.minSpeed = 0.0f;
+    config.maxSpeed = 0.0f;
+    config.gravity = Vector2D(0, 100);
+    emitter->SetConfig(config);
+
+    emitter->Emit(1);
+    emitter->Update(0.1f);
+    emitter->Update(0.1f);
+
+    // Semi-implicit Euler: v1 = 10, v2 = 20, y = 0.1 * (10 + 20)
+    EXPECT_NEAR(emitter->GetParticlePosition(0).y, 3.0f, 0.001f);
+}
+
+TEST_F(ParticleEmitterTest, DeadParticlesAreRemoved) {
+    auto config = emitter->GetConfig();
+    config.minLifetime = 0.5f;
+    config.maxLifetime = 0.5f;
+    emitter->SetConfig(config);
+    emitter->Emit(10);
+
+    config.minLifetime = 2.0f;
+    config.maxLifetime = 2.0f;
+    emitter->SetConfig(config);
+    emitter->Emit(5);
+
+    emitter->Update(0.6f);
+    EXPECT_EQ(emitter->GetAliveCount(), 5);
+
+    emitter->Update(2.0f);
+    EXPECT_EQ(emitter->GetAliveCount(), 0);
+}
+
+TEST_F(ParticleEmitterTest, ContinuousEmission) {
+    auto config = emitter->GetConfig();
+    config.emissionRate = 10.0f;
+    config.minLifetime = 10.0f;
+    config.maxLifetime = 10.0f;
+    emitter->SetConfig(config);
+
+    for (int i = 0; i < 10; ++i) {
+        emitter->Update(0.1f);
+    }
+    EXPECT_EQ(emitter->GetAliveCount(), 10);
+
+    emitter->SetEmitting(false);
+    emitter->Update(1.0f);
+    EXPECT_EQ(emitter->GetAliveCount(), 10);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "debug/profiler.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Profiler::Instance().SetEnabled(true);
+        Profiler::Instance().Reset();
+    }
+
+    void TearDown() override {
+        Profiler::Instance().StopCapture();
+        Profiler::Instance().SetSpikeCapture(0.0, "");
+        Profiler::Instance().SetEnabled(true);
+        Profiler::Instance().Reset();
+    }
+
+    static std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    static size_t Count(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    static void Work() {
+        auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+};
+
+TEST_F(ProfilerTest, NestedZonesFormATree) {
+    auto& profiler = Profiler::Instance();
+    {
+        ProfileZone frame("Frame");
+        for (int i = 0; i < 3; ++i) {
+            ProfileZone update("Update");
+            Work();
+        }
+        {
+            ProfileZone render("Render");
+            ProfileZone sprites("Sprites");
+            Work();
+        }
+    }
+    profiler.EndFrame();
+
+    const auto& stats = profiler.GetLastFrame();
+    ASSERT_EQ(stats.zones.size(), 4u);
+    EXPECT_EQ(stats.droppedZones, 0u);
+
+    const auto* frame = stats.Find("Frame");
+    const auto* update = stats.Find("Update");
+    const auto* render = stats.Find("Render");
+    const auto* sprites = stats.Find("Sprites");
+    ASSERT_TRUE(frame && update && render && sprites);
+
+    EXPECT_EQ(frame->parent, -1);
+    EXPECT_EQ(frame->depth, 0u);
+    EXPECT_EQ(&stats.zones[update->parent], frame);
+    EXPECT_EQ(&stats.zones[sprites->parent], render);
+    EXPECT_EQ(sprites->depth, 2u);
+
+    // Repeated calls at the same place are merged
+    EXPECT_EQ(update->calls, 3u);
+    EXPECT_GT(update->totalMs, 0.5);
+    EXPECT_NEAR(update->selfMs, update->totalMs, 1e-9);
+
+    // A parent's self time excludes its children
+    EXPECT_GE(frame->totalMs, update->totalMs + render->totalMs);
+    EXPECT_NEAR(frame->selfMs, frame->totalMs - update->totalMs - render->totalMs, 1e-6);
+    EXPECT_LT(render->selfMs, render->totalMs);
+}
+
+TEST_F(ProfilerTest, FramesAndThreadsAreSeparate) {
+    auto& profiler = Profiler::Instance();
+    {
+        ProfileZone zone("Main");
+    }
+    std::thread worker([] {
+        Profiler::Instance().SetThreadName("Worker");
+        ProfileZone zone("Job");
+    });
+    worker.join();
+    profiler.EndFrame();
+
+    const auto& stats = profiler.GetLastFrame();
+    const auto* main = stats.Find("Main");
+    const auto* job = stats.Find("Job");
+    ASSERT_TRUE(main && job);
+    EXPECT_NE(main->thread, job->thread);
+    EXPECT_EQ(job->parent, -1);
+    EXPECT_STREQ(profiler.GetThreadName(job->thread), "Worker");
+
+    // Zones are collected once; the next frame starts empty
+    profiler.EndFrame();
+    EXPECT_TRUE(profiler.GetLastFrame().zones.empty());
+    EXPECT_EQ(profiler.GetHistory().size(), 2u);
+    EXPECT_EQ(profiler.GetHistory().back().frame, profiler.GetHistory().front().frame + 1);
+}
+
+TEST_F(ProfilerTest, DisabledRecordsNothing) {
+    auto& profiler = Profiler::Instance();
+    profiler.SetEnabled(false);
+    {
+        ProfileZone zone("Ignored");
+    }
+    profiler.EndFrame();
+    EXPECT_TRUE(profiler.GetLastFrame().zones.empty());
+
+    profiler.SetHistorySize(1);
+    profiler.EndFrame();
+    EXPECT_EQ(profiler.GetHistory().size(), 1u);
+    profiler.SetHistorySize(120);
+}
+
+TEST_F(ProfilerTest, CountersKeepLastValue) {
+    auto& profiler = Profiler::Instance();
+    profiler.RecordCounter("Objects", 10.0);
+    profiler.RecordCounter("Objects", 12.0);
+    profiler.EndFrame();
+
+    const auto& counters = profiler.GetLastFrame().counters;
+    ASSERT_EQ(counters.size(), 1u);
+    EXPECT_STREQ(counters[0].name, "Objects");
+    EXPECT_DOUBLE_EQ(counters[0].value, 12.0);
+    EXPECT_TRUE(profiler.GetLastFrame().zones.empty());
+}
+
+TEST_F(ProfilerTest, CaptureStreamsFramesToTrace) {
+    auto& profiler = Profiler::Instance();
+    const auto path = std::filesystem::temp_directory_path() / "gameframework_profiler_capture.json";
+
+    ASSERT_TRUE(profiler.StartCapture(path.string(), 2));
+    for (int i = 0; i < 3; ++i) {
+        ProfileZone zone("Frame \"quoted\"");
+        profiler.RecordCounter("Objects", i);
+    }
+    profiler.EndFrame();
+    EXPECT_TRUE(profiler.IsCapturing());
+    {
+        ProfileZone zone("Second");
+    }
+    profiler.EndFrame();
+    EXPECT_FALSE(profiler.IsCapturing());
+    {
+        ProfileZone zone("NotCaptured");
+    }
+    profiler.EndFrame();
+
+    const std::string trace = ReadFile(path);
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(trace.find("]}"), std::string::npos);
+    EXPECT_EQ(Count(trace, "\"name\":\"Frame \\\"quoted\\\"\""), 3u);
+    EXPECT_EQ(Count(trace, "\"name\":\"Second\""), 1u);
+    EXPECT_EQ(Count(trace, "NotCaptured"), 0u);
+    EXPECT_EQ(Count(trace, "\"ph\":\"i\""), 2u);
+    EXPECT_EQ(Count(trace, "\"ph\":\"C\",\"name\":\"Objects\""), 3u);
+    std::filesystem::remove(path);
+}
+
+TEST_F(ProfilerTest, SpikeCaptureWritesSlowFrames) {
+    auto& profiler = Profiler::Instance();
+    const auto prefix = std::filesystem::temp_directory_path() / "gameframework_profiler_spike";
+    profiler.SetSpikeCapture(5.0, prefix.string(), 1);
+
+    profiler.EndFrame();
+    {
+        ProfileZone zone("Before");
+    }
+    profiler.EndFrame();
+    {
+        ProfileZone zone("Spike");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    profiler.EndFrame();
+
+    const std::uint64_t spikeFrame = profiler.GetLastFrame().frame;
+    const auto spikePath = prefix.string() + "_frame" + std::to_string(spikeFrame) + ".json";
+    ASSERT_TRUE(std::filesystem::exists(spikePath));
+    const std::string trace = ReadFile(spikePath);
+    EXPECT_EQ(Count(trace, "\"name\":\"Spike\""), 1u);
+    EXPECT_EQ(Count(trace, "\"name\":\"Before\""), 1u);
+    EXPECT_EQ(Count(trace, "\"ph\":\"i\""), 2u);
+    EXPECT_FALSE(std::filesystem::exists(prefix.string() + "_frame" + std::to_string(spikeFrame - 1) + ".json"));
+    std::filesystem::remove(spikePath);
+}
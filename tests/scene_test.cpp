@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "camera.h"
+#include "scene.h"
+
+namespace {
+
+class CountingObject : public GameObject {
+public:
+    explicit CountingObject(const Vector2D& position) : GameObject("counter") {
+        GetTransform().position = position;
+    }
+
+    void Update(float deltaTime) override {
+        ++updates;
+        elapsed += deltaTime;
+    }
+
+    int updates = 0;
+    float elapsed = 0.0f;
+};
+
+} // namespace
+
+class SceneUpdateLodTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // View covers (-50, -50) to (50, 50)
+        scene.AddCamera(std::make_shared<Camera>(SDL_Rect{0, 0, 100, 100}));
+        scene.SetUpdateLodTiers({{500.0f, 4}, {0.0f, 1}});
+
+        nearby = std::make_shared<CountingObject>(Vector2D(10.0f, 10.0f));
+        distant = std::make_shared<CountingObject>(Vector2D(1000.0f, 0.0f));
+        scene.AddGameObject(nearby);
+        scene.AddGameObject(distant);
+    }
+
+    Scene scene;
+    std::shared_ptr<CountingObject> nearby;
+    std::shared_ptr<CountingObject> distant;
+};
+
+TEST_F(SceneUpdateLodTest, DistantObjectsUpdateLessOften) {
+    ASSERT_EQ(scene.GetUpdateLodTiers().front().distance, 0.0f);
+
+    for (int i = 0; i < 16; ++i) {
+        scene.Update(0.01f);
+    }
+
+    EXPECT_EQ(nearby->updates, 16);
+    EXPECT_LE(distant->updates, 5);
+    EXPECT_GE(distant->updates, 4);
+
+    // No time is lost, only delivered in larger steps
+    EXPECT_NEAR(nearby->elapsed, 0.16f, 1e-4f);
+    EXPECT_LE(distant->elapsed, 0.16f + 1e-4f);
+    EXPECT_GE(distant->elapsed, 0.16f - 0.04f);
+}
+
+TEST_F(SceneUpdateLodTest, PinnedTierOverridesDistance) {
+    distant->SetUpdateTier(0);
+    for (int i = 0; i < 8; ++i) {
+        scene.Update(0.01f);
+    }
+    EXPECT_EQ(distant->updates, 8);
+    EXPECT_EQ(scene.GetUpdatedObjectCount(), 2u);
+
+    // Disabling LOD delivers whatever time was still pending
+    distant->SetUpdateTier(GameObject::kAutoUpdateTier);
+    for (int i = 0; i < 3; ++i) {
+        scene.Update(0.01f);
+    }
+    scene.SetUpdateLodTiers({});
+    scene.Update(0.01f);
+    EXPECT_NEAR(distant->elapsed, 0.12f, 1e-4f);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "spritesheet.h"
+#include <string>
+
+namespace {
+    const char* kHashJson = R"({
+        "frames": {
+            "hero 0.aseprite": { "frame": { "x": 0, "y": 0, "w": 16, "h": 24 }, "duration": 100 },
+            "hero 1.aseprite": { "frame": { "x": 16, "y": 0, "w": 16, "h": 24 }, "duration": 150 },
+            "hero 2.aseprite": { "frame": { "x": 32, "y": 0, "w": 16, "h": 24 }, "duration": 100 },
+            "hero 3.aseprite": { "frame": { "x": 48, "y": 0, "w": 16, "h": 24 }, "duration": 200 }
+        },
+        "meta": {
+            "image": "hero.png",
+            "frameTags": [
+                { "name": "idle", "from": 0, "to": 1, "direction": "forward" },
+                { "name": "run", "from": 1, "to": 3, "direction": "pingpong" },
+                { "name": "die", "from": 2, "to": 3, "direction": "reverse", "repeat": "1" }
+            ]
+        }
+    })";
+}
+
+TEST(SpriteSheetTest, ParsesAsepriteHashJson) {
+    std::string error;
+    auto sheet = SpriteSheet::FromJson(kHashJson, &error);
+    ASSERT_NE(sheet, nullptr) << error;
+
+    EXPECT_EQ(sheet->GetImagePath(), "hero.png");
+    ASSERT_EQ(sheet->GetClips().size(), 3);
+
+    auto idle = sheet->GetClip(sheet->FindClip("idle"));
+    ASSERT_NE(idle, nullptr);
+    ASSERT_EQ(idle->frames.size(), 2);
+    EXPECT_EQ(idle->frames[1].sourceRect.x, 16);
+    EXPECT_FLOAT_EQ(idle->frames[1].duration, 0.15f);
+    EXPECT_TRUE(idle->looping);
+
+    // Ping-pong plays 1 2 3 2, reverse plays 3 2
+    auto run = sheet->GetClip(sheet->FindClip("run"));
+    ASSERT_EQ(run->frames.size(), 4);
+    EXPECT_EQ(run->frames[2].sourceRect.x, 48);
+    EXPECT_EQ(run->frames[3].sourceRect.x, 32);
+
+    auto die = sheet->GetClip(sheet->FindClip("die"));
+    ASSERT_EQ(die->frames.size(), 2);
+    EXPECT_EQ(die->frames[0].sourceRect.x, 48);
+    EXPECT_FALSE(die->looping);
+
+    EXPECT_EQ(sheet->FindClip("missing"), SpriteSheet::kInvalidClip);
+    EXPECT_EQ(sheet->GetClip(SpriteSheet::kInvalidClip), nullptr);
+}
+
+TEST(SpriteSheetTest, ArrayJsonWithoutTagsIsOneClip) {
+    auto sheet = SpriteSheet::FromJson(R"({"frames": [
+        {"filename": "a", "frame": {"x": 0, "y": 0, "w": 8, "h": 8}, "duration": 50},
+        {"filename": "b", "frame": {"x": 8, "y": 0, "w": 8, "h": 8}, "duration": 50}
+    ]})");
+    ASSERT_NE(sheet, nullptr);
+    ASSERT_EQ(sheet->GetClips().size(), 1);
+    EXPECT_EQ(sheet->GetClips()[0]->name, "default");
+    EXPECT_EQ(sheet->GetClips()[0]->frames.size(), 2);
+}
+
+TEST(SpriteSheetTest, RejectsMalformedJson) {
+    std::string error;
+    EXPECT_EQ(SpriteSheet::FromJson(R"({"frames": [)", &error), nullptr);
+    EXPECT_FALSE(error.empty());
+    EXPECT_EQ(SpriteSheet::FromJson(R"({"meta": {}})"), nullptr);
+    EXPECT_EQ(SpriteSheet::FromJson(R"({"frames": [], "meta": {"frameTags": [{"name": "x", "from": 0, "to": 2}]}})"), nullptr);
+}
+
+TEST(SpriteSheetTest, BinaryRoundTrip) {
+    auto sheet = SpriteSheet::FromJson(kHashJson);
+    ASSERT_NE(sheet, nullptr);
+
+    std::vector<std::uint8_t> binary = sheet->ToBinary();
+    ASSERT_FALSE(binary.empty());
+    EXPECT_EQ(binary.size(), sheet->GetByteSize());
+
+    auto loaded = SpriteSheet::FromMemory(binary.data(), binary.size());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->GetImagePath(), "hero.png");
+    ASSERT_EQ(loaded->GetClips().size(), sheet->GetClips().size());
+
+    for (size_t i = 0; i < sheet->GetClips().size(); ++i) {
+        const auto& expected = *sheet->GetClips()[i];
+        const auto& actual = *loaded->GetClips()[i];
+        EXPECT_EQ(actual.name, expected.name);
+        EXPECT_EQ(actual.looping, expected.looping);
+        ASSERT_EQ(actual.frames.size(), expected.frames.size());
+        for (size_t f = 0; f < expected.frames.size(); ++f) {
+            EXPECT_EQ(actual.frames[f].sourceRect.x, expected.frames[f].sourceRect.x);
+            EXPECT_EQ(actual.frames[f].sourceRect.h, expected.frames[f].sourceRect.h);
+            EXPECT_EQ(actual.frames[f].duration, expected.frames[f].duration);
+        }
+    }
+    EXPECT_EQ(loaded->FindClip("run"), sheet->FindClip("run"));
+
+    // Truncated data is rejected
+    EXPECT_EQ(SpriteSheet::FromBinary(binary.data(), binary.size() - 1), nullptr);
+}
+
+TEST(SpriteSheetTest, ControllersShareClipFrames) {
+    auto sheet = SpriteSheet::FromJson(kHashJson);
+    ASSERT_NE(sheet, nullptr);
+
+    AnimationController first;
+    AnimationController second;
+    AnimationController::AnimationId base = first.AddClips(sheet->GetClips());
+    second.AddClips(sheet->GetClips());
+
+    const SpriteSheet::ClipId run = sheet->FindClip("run");
+    EXPECT_EQ(first.FindAnimation("run"), base + run);
+    EXPECT_EQ(&first.GetAnimation(base + run)->GetFrames(), &second.GetAnimation(run)->GetFrames());
+
+    first.Play(base + run);
+    EXPECT_EQ(first.GetCurrentAnimation()->GetCurrentFrame().sourceRect.x, 16);
+    first.Update(0.15f);
+    EXPECT_EQ(first.GetCurrentAnimation()->GetCurrentFrame().sourceRect.x, 32);
+
+    // Editing one instance copies the frames instead of changing the shared clip
+    Animation* edited = second.GetAnimation(run);
+    edited->AddFrame({0, 24, 16, 24}, 0.1f);
+    EXPECT_EQ(edited->GetFrames().size(), 5);
+    EXPECT_EQ(sheet->GetClip(run)->frames.size(), 4);
+}
+
+TEST(SpriteSheetTest, AddClipsReplacesAnimationsWithTheSameName) {
+    auto sheet = SpriteSheet::FromJson(kHashJson);
+    ASSERT_NE(sheet, nullptr);
+
+    AnimationController controller;
+    const AnimationController::AnimationId existing = controller.AddAnimation("run");
+    controller.AddAnimation("other");
+    controller.AddClips(sheet->GetClips());
+
+    EXPECT_EQ(controller.FindAnimation("run"), existing);
+    EXPECT_EQ(controller.GetAnimation(existing)->GetFrames().size(), 4);
+    EXPECT_EQ(AnimationController().AddClips({}), AnimationController::kInvalidAnimation);
+}
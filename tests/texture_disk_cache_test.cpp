@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "texture-disk-cache.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class TextureDiskCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(cache.SetDirectory(directory));
+    }
+
+    void TearDown() override {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+
+    // Write a cache file by hand following the documented layout
+    void WriteCacheFile(const std::string& source, std::uint64_t stamp, std::uint32_t width,
+                        std::uint32_t height, size_t pixelBytes) {
+        std::vector<std::uint8_t> file((TextureDiskCache::kHeaderSize + source.size() + 15) / 16 * 16, 0);
+        std::memcpy(file.data(), TextureDiskCache::kMagic, 4);
+        auto put32 = [&](size_t at, std::uint32_t v) { std::memcpy(file.data() + at, &v, 4); };
+        put32(4, TextureDiskCache::kVersion);
+        put32(8, width);
+        put32(12, height);
+        std::memcpy(file.data() + 16, &stamp, 8);
+        put32(24, static_cast<std::uint32_t>(source.size()));
+        std::memcpy(file.data() + TextureDiskCache::kHeaderSize, source.data(), source.size());
+        for (size_t i = 0; i < pixelBytes; ++i) {
+            file.push_back(static_cast<std::uint8_t>(i));
+        }
+
+        std::ofstream out(cache.GetCacheFile(source), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    }
+
+    std::string directory = ::testing::TempDir() + "texture_disk_cache_test";
+    TextureDiskCache cache;
+};
+
+TEST_F(TextureDiskCacheTest, CacheFileDependsOnSourcePath) {
+    EXPECT_TRUE(cache.IsEnabled());
+    EXPECT_EQ(cache.GetCacheFile("assets/a.png"), cache.GetCacheFile("assets/a.png"));
+    EXPECT_NE(cache.GetCacheFile("assets/a.png"), cache.GetCacheFile("assets/b.png"));
+}
+
+TEST_F(TextureDiskCacheTest, LoadsMatchingFile) {
+    WriteCacheFile("assets/a.png", 42, 2, 3, 2 * 3 * 4);
+
+    TextureDiskCache::Image image;
+    ASSERT_TRUE(cache.Load("assets/a.png", 42, image));
+    EXPECT_EQ(image.width, 2);
+    EXPECT_EQ(image.height, 3);
+    EXPECT_EQ(image.GetPitch(), 8);
+    EXPECT_EQ(image.pixelOffset % 16, 0);
+    EXPECT_EQ(static_cast<const std::uint8_t*>(image.GetPixels())[5], 5);
+}
+
+TEST_F(TextureDiskCacheTest, RejectsStaleOrCorruptFiles) {
+    TextureDiskCache::Image image;
+    EXPECT_FALSE(cache.Load("assets/missing.png", 1, image));
+
+    // Source changed since the file was written
+    WriteCacheFile("assets/a.png", 42, 2, 2, 16);
+    EXPECT_FALSE(cache.Load("assets/a.png", 43, image));
+
+    // Truncated pixel data
+    WriteCacheFile("assets/b.png", 7, 4, 4, 10);
+    EXPECT_FALSE(cache.Load("assets/b.png", 7, image));
+}
+
+TEST_F(TextureDiskCacheTest, DisabledWithEmptyDirectory) {
+    ASSERT_TRUE(cache.SetDirectory(""));
+    EXPECT_FALSE(cache.IsEnabled());
+
+    TextureDiskCache::Image image;
+    EXPECT_FALSE(cache.Load("assets/a.png", 42, image));
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "threadpool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPoolTest, RunsJobsAndReturnsResults) {
+    ThreadPool pool(2);
+    EXPECT_EQ(pool.GetThreadCount(), 2);
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 16; ++i) {
+        results.push_back(pool.Submit([i]() { return i * i; }));
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+}
+
+TEST(ThreadPoolTest, PropagatesExceptions) {
+    ThreadPool pool(1);
+    auto result = pool.Submit([]() -> int { throw std::runtime_error("decode failed"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, DestructorFinishesQueuedJobs) {
+    std::atomic<int> completed{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 32; ++i) {
+            pool.Submit([&completed]() { ++completed; });
+        }
+    }
+    EXPECT_EQ(completed.load(), 32);
+}
+
+TEST(ThreadPoolTest, DefaultThreadCount) {
+    ThreadPool pool;
+    EXPECT_GE(pool.GetThreadCount(), 1);
+}
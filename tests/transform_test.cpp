@@ -109,4 +109,30 @@ TEST_F(TransformTest, ComplexTransformation) {
     float sqrt2_2 = std::sqrt(2.0f) / 2.0f;
     Vector2D expectedForward(sqrt2_2, sqrt2_2);
     EXPECT_TRUE(VectorsEqual(transform.GetForward(), expectedForward, 0.0001f));
-}
\ No newline at end of file
+}
+
+TEST_F(TransformTest, MatrixMatchesComponents) {
+    Transform transform(Vector2D(10.0f, 20.0f), Vector2D(2.0f, 3.0f), 90.0f);
+
+    // Local (1, 1) is scaled to (2, 3), rotated to (-3, 2), then translated
+    Vector2D world = transform.GetMatrix().TransformPoint(Vector2D(1.0f, 1.0f));
+    EXPECT_TRUE(VectorsEqual(world, Vector2D(7.0f, 22.0f), 0.0001f));
+}
+
+TEST_F(TransformTest, CachesFollowDirectFieldWrites) {
+    Transform transform;
+    EXPECT_TRUE(VectorsEqual(transform.GetMatrix().TransformPoint(Vector2D(1.0f, 0.0f)),
+                             Vector2D(1.0f, 0.0f)));
+
+    // Fields are public; caches must notice writes that bypass any setter
+    transform.position = Vector2D(5.0f, 0.0f);
+    transform.rotation = 180.0f;
+    EXPECT_TRUE(VectorsEqual(transform.GetMatrix().TransformPoint(Vector2D(1.0f, 0.0f)),
+                             Vector2D(4.0f, 0.0f)));
+    EXPECT_NEAR(transform.GetCos(), -1.0f, 0.0001f);
+    EXPECT_NEAR(transform.GetSin(), 0.0f, 0.0001f);
+
+    transform.scale = Vector2D(3.0f, 3.0f);
+    EXPECT_TRUE(VectorsEqual(transform.GetMatrix().TransformPoint(Vector2D(1.0f, 0.0f)),
+                             Vector2D(2.0f, 0.0f)));
+}
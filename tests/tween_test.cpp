@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "tweenmanager.h"
+#include "camera.h"
+#include "ui/ui_element.h"
+
+TEST(TweenTest, EasingEndpoints) {
+    for (int e = 0; e <= static_cast<int>(Ease::BounceOut); ++e) {
+        const Ease ease = static_cast<Ease>(e);
+        EXPECT_NEAR(TweenManager::Evaluate(ease, 0.0f), 0.0f, 1e-5f);
+        EXPECT_NEAR(TweenManager::Evaluate(ease, 1.0f), 1.0f, 1e-5f);
+    }
+    EXPECT_FLOAT_EQ(TweenManager::Evaluate(Ease::QuadIn, 0.5f), 0.25f);
+    EXPECT_FLOAT_EQ(TweenManager::Evaluate(Ease::QuadOut, 0.5f), 0.75f);
+    EXPECT_FLOAT_EQ(TweenManager::Evaluate(Ease::Linear, 2.0f), 1.0f);
+}
+
+TEST(TweenTest, ValuesAndCompletion) {
+    TweenManager tweens;
+    float alpha = 0.0f;
+    Vector2D point(0, 0);
+    SDL_Color color{0, 0, 0, 255};
+
+    auto a = tweens.To(&alpha, 10.0f, 1.0f);
+    tweens.To(&point, Vector2D(4, 8), 0.5f);
+    tweens.To(&color, SDL_Color{255, 100, 0, 255}, 1.0f);
+    int completed = 0;
+    tweens.OnComplete(a, [&] {
+        ++completed;
+        // Completion callbacks may chain new tweens
+        tweens.To(&alpha, 0.0f, 1.0f);
+    });
+    EXPECT_EQ(tweens.GetActiveCount(), 3u);
+
+    tweens.Update(0.25f);
+    EXPECT_FLOAT_EQ(alpha, 2.5f);
+    EXPECT_EQ(point, Vector2D(2, 4));
+    EXPECT_EQ(color.r, 64);
+
+    tweens.Update(0.75f);
+    EXPECT_FLOAT_EQ(alpha, 10.0f);
+    EXPECT_EQ(point, Vector2D(4, 8));
+    EXPECT_EQ(color.g, 100);
+    EXPECT_EQ(completed, 1);
+    EXPECT_FALSE(tweens.IsActive(a));
+    EXPECT_EQ(tweens.GetActiveCount(), 1u);
+
+    // A new tween reusing the slot does not answer to the stale handle
+    tweens.Kill(a, true);
+    EXPECT_EQ(tweens.GetActiveCount(), 1u);
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(alpha, 5.0f);
+}
+
+TEST(TweenTest, DelayRepeatAndKill) {
+    TweenManager tweens;
+    float value = 0.0f;
+    auto handle = tweens.To(&value, 1.0f, 1.0f);
+    tweens.SetDelay(handle, 0.5f);
+    tweens.SetRepeat(handle, 1, true);
+
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+    tweens.Update(1.0f);
+    EXPECT_FLOAT_EQ(value, 1.0f);
+
+    // The second run plays backwards, then the tween ends
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(value, 0.5f);
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+    EXPECT_FALSE(tweens.IsActive(handle));
+
+    float other = 0.0f;
+    tweens.To(&value, 1.0f, 1.0f);
+    tweens.To(&other, 1.0f, 1.0f);
+    tweens.KillTweensOf(&value);
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(value, 0.0f);
+    EXPECT_FLOAT_EQ(other, 0.5f);
+}
+
+TEST(TweenTest, CameraAndUIProperties) {
+    TweenManager tweens;
+    Camera camera(SDL_Rect{0, 0, 800, 600});
+    UIElement element;
+
+    tweens.MoveTo(camera, Vector2D(100, 50), 1.0f, Ease::QuadOut);
+    tweens.ZoomTo(camera, 2.0f, 1.0f);
+    tweens.ScaleTo(element, Vector2D(2, 2), 1.0f);
+    tweens.MoveTo(element, Vector2D(10, 20), 1.0f);
+
+    tweens.Update(0.5f);
+    EXPECT_EQ(camera.GetPosition(), Vector2D(75, 37.5f));
+    EXPECT_FLOAT_EQ(camera.GetZoom(), 1.5f);
+    EXPECT_EQ(element.GetScale(), Vector2D(1.5f, 1.5f));
+    EXPECT_EQ(element.GetPosition(), Vector2D(5, 10));
+
+    // The camera's view follows the tweened values
+    EXPECT_EQ(camera.WorldToScreen(Vector2D(75, 37.5f)), Vector2D(400, 300));
+
+    tweens.Update(0.5f);
+    EXPECT_FLOAT_EQ(camera.GetZoom(), 2.0f);
+    EXPECT_EQ(tweens.GetActiveCount(), 0u);
+}
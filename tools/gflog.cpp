@@ -0,0 +1,75 @@
+// gflog: decode a binary log written with LogEncoding::Binary into text
+//
+// Usage:
+//   gflog <input.gflog> [output.log]
+//
+// Lines match the text log format. Without an output file they are written
+// to stdout.
+
+#include <debug/binarylog.h>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+namespace {
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "Usage:\n"
+            "  gflog <input.gflog> [output.log]\n");
+    }
+
+    void FormatTimestamp(std::int64_t nanoseconds, char* out, size_t size) {
+        const std::int64_t millis = nanoseconds / 1000000;
+        const std::time_t seconds = static_cast<std::time_t>(millis / 1000);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        const size_t length = std::strftime(out, size, "%Y-%m-%d %H:%M:%S", &local);
+        std::snprintf(out + length, size - length, ".%03d", static_cast<int>(millis % 1000));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.Open(argv[1])) {
+        std::fprintf(stderr, "gflog: '%s' is not a binary log\n", argv[1]);
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if (argc == 3) {
+        output = std::fopen(argv[2], "w");
+        if (!output) {
+            std::fprintf(stderr, "gflog: cannot write '%s'\n", argv[2]);
+            return 1;
+        }
+    }
+
+    BinaryLogReader::Entry entry;
+    size_t count = 0;
+    char timestamp[32];
+    while (reader.Next(entry)) {
+        FormatTimestamp(entry.timestamp, timestamp, sizeof(timestamp));
+        std::fprintf(output, "%s [%s] %.*s\n", timestamp, DebugLogger::GetLevelString(entry.level),
+                     static_cast<int>(entry.text.size()), entry.text.data());
+        ++count;
+    }
+
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    if (reader.HasError()) {
+        std::fprintf(stderr, "gflog: '%s' is truncated or corrupt after %zu messages\n", argv[1], count);
+        return 1;
+    }
+    return 0;
+}
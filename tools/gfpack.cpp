@@ -0,0 +1,93 @@
+// gfpack: bundle asset directories into a pack file readable by AssetManager::MountPack
+//
+// Usage:
+//   gfpack [--lz4] <output.gfpack> <directory>...
+//   gfpack --list <pack.gfpack>
+//
+// Entries are named by their path relative to the directory they were found
+// in, using '/' separators, so mounting the pack at "assets" serves
+// "assets/player.png" from <directory>/player.png.
+
+#include <asset-pack.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "Usage:\n"
+            "  gfpack [--lz4] <output.gfpack> <directory>...\n"
+            "  gfpack --list <pack.gfpack>\n");
+    }
+
+    int ListPack(const std::string& path) {
+        auto pack = AssetPack::Open(path);
+        if (!pack) {
+            std::fprintf(stderr, "gfpack: cannot open '%s'\n", path.c_str());
+            return 1;
+        }
+
+        for (const auto& entry : pack->GetEntries()) {
+            std::printf("%10zu %10zu %s %.*s\n", entry.size, entry.storedSize,
+                        entry.compression == AssetPack::Compression::LZ4 ? "lz4 " : "raw ",
+                        static_cast<int>(entry.name.size()), entry.name.data());
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    if (args.size() == 2 && args[0] == "--list") {
+        return ListPack(args[1]);
+    }
+
+    AssetPackWriter writer;
+    size_t first = 0;
+    if (!args.empty() && args[0] == "--lz4") {
+        if (!AssetPack::IsCompressionSupported()) {
+            std::fprintf(stderr, "gfpack: built without LZ4 support, writing uncompressed\n");
+        }
+        writer.SetCompression(true);
+        first = 1;
+    }
+
+    if (args.size() < first + 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string& output = args[first];
+    for (size_t i = first + 1; i < args.size(); ++i) {
+        const fs::path root(args[i]);
+        std::error_code error;
+        if (!fs::is_directory(root, error)) {
+            std::fprintf(stderr, "gfpack: '%s' is not a directory\n", args[i].c_str());
+            return 1;
+        }
+
+        for (const auto& item : fs::recursive_directory_iterator(root)) {
+            if (!item.is_regular_file()) continue;
+
+            std::string name = item.path().lexically_relative(root).generic_string();
+            if (!writer.AddFile(name, item.path().string())) {
+                std::fprintf(stderr, "gfpack: cannot read '%s'\n", item.path().string().c_str());
+                return 1;
+            }
+        }
+    }
+
+    if (!writer.Write(output)) {
+        std::fprintf(stderr, "gfpack: cannot write '%s'\n", output.c_str());
+        return 1;
+    }
+
+    std::printf("gfpack: wrote %zu entries to %s\n", writer.GetEntryCount(), output.c_str());
+    return 0;
+}
@@ -0,0 +1,82 @@
+// gfsheet: compile Aseprite sprite sheet JSON into the binary form read by
+// AssetManager::LoadSpriteSheet
+//
+// Usage:
+//   gfsheet <input.json> <output.gfsheet>
+//   gfsheet --list <sheet>
+
+#include <spritesheet.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "Usage:\n"
+            "  gfsheet <input.json> <output.gfsheet>\n"
+            "  gfsheet --list <sheet>\n");
+    }
+
+    std::shared_ptr<SpriteSheet> ReadSheet(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "gfsheet: cannot read '%s'\n", path.c_str());
+            return nullptr;
+        }
+
+        std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::string error;
+        auto sheet = SpriteSheet::FromMemory(data.data(), data.size(), &error);
+        if (!sheet) {
+            std::fprintf(stderr, "gfsheet: '%s': %s\n", path.c_str(), error.c_str());
+        }
+        return sheet;
+    }
+
+    int ListSheet(const std::string& path) {
+        auto sheet = ReadSheet(path);
+        if (!sheet) return 1;
+
+        std::printf("image: %s\n", sheet->GetImagePath().c_str());
+        for (size_t id = 0; id < sheet->GetClips().size(); ++id) {
+            const auto& clip = sheet->GetClips()[id];
+            std::printf("%4zu %-24s %3zu frames%s\n", id, clip->name.c_str(), clip->frames.size(),
+                        clip->looping ? ", looping" : "");
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() != 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (args[0] == "--list") {
+        return ListSheet(args[1]);
+    }
+
+    auto sheet = ReadSheet(args[0]);
+    if (!sheet) return 1;
+
+    std::vector<std::uint8_t> binary = sheet->ToBinary();
+    if (binary.empty()) {
+        std::fprintf(stderr, "gfsheet: '%s' has frames outside the 16-bit range of the binary format\n",
+                     args[0].c_str());
+        return 1;
+    }
+
+    std::ofstream out(args[1], std::ios::binary | std::ios::trunc);
+    if (!out.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()))) {
+        std::fprintf(stderr, "gfsheet: cannot write '%s'\n", args[1].c_str());
+        return 1;
+    }
+
+    std::printf("gfsheet: wrote %zu clips to %s\n", sheet->GetClips().size(), args[1].c_str());
+    return 0;
+}